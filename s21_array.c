@@ -0,0 +1,1404 @@
+#include "s21_decimal.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define S21_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// верхний уровень векторных ядер, см. s21_simd_limit
+static int simd_limit = SIMD_AVX512;
+
+/**
+ * @brief Выделение массива, выровненного по строке кэша, размер
+ * округляется вверх до COLUMN_ALIGN байт
+ *
+ * @param size размер в байтах
+ * @param Владимир
+ * @return void* указатель на память или NULL
+ */
+void *s21_column_alloc(size_t size) {
+  size = (size + COLUMN_ALIGN - 1) / COLUMN_ALIGN * COLUMN_ALIGN;
+  return aligned_alloc(COLUMN_ALIGN, size ? size : COLUMN_ALIGN);
+}
+
+/**
+ * @brief Упаковка знака и степени числа Decimal в байт: знак в старшем
+ * бите, степень в младших пяти
+ *
+ * @param value число децимал
+ * @param Владимир
+ * @return uint8_t байт знака и степени
+ */
+uint8_t s21_column_pack(s21_decimal value) {
+  return (uint8_t)(s21_scale(value) | s21_bit(value, 127) << 7);
+}
+
+/**
+ * @brief Создание пустой колонки
+ *
+ * @param col указатель на колонку
+ * @param capacity количество элементов, под которое сразу выделяется память
+ * @param Владимир
+ * @return int 0 - OK, 1 - ошибка выделения памяти
+ */
+int s21_column_init(s21_decimal_column *col, size_t capacity) {
+  *col = (s21_decimal_column){0};
+  col->owner = TRUE;
+  return s21_column_reserve(col, capacity);
+}
+
+/**
+ * @brief Освобождение памяти колонки, срез памяти не владеет и ничего не
+ * освобождает
+ *
+ * @param col указатель на колонку
+ * @param Владимир
+ */
+void s21_column_free(s21_decimal_column *col) {
+  if (col->owner) {
+    free(col->lo);
+    free(col->mid);
+    free(col->hi);
+    free(col->meta);
+  }
+  *col = (s21_decimal_column){0};
+}
+
+/**
+ * @brief Выделение памяти под capacity элементов с сохранением данных
+ *
+ * @param col указатель на колонку
+ * @param capacity новое количество элементов
+ * @param Владимир
+ * @return int 0 - OK, 1 - ошибка выделения памяти или колонка - срез
+ */
+int s21_column_reserve(s21_decimal_column *col, size_t capacity) {
+  int rez = col->owner ? OK : ERROR;
+  if (rez == OK && (capacity > col->capacity || !col->lo)) {
+    uint32_t *lo = s21_column_alloc(capacity * sizeof(uint32_t));
+    uint32_t *mid = s21_column_alloc(capacity * sizeof(uint32_t));
+    uint32_t *hi = s21_column_alloc(capacity * sizeof(uint32_t));
+    uint8_t *meta = s21_column_alloc(capacity);
+    if (!lo || !mid || !hi || !meta) {
+      free(lo), free(mid), free(hi), free(meta);
+      rez = ERROR;
+    } else {
+      if (col->size) {
+        memcpy(lo, col->lo, col->size * sizeof(uint32_t));
+        memcpy(mid, col->mid, col->size * sizeof(uint32_t));
+        memcpy(hi, col->hi, col->size * sizeof(uint32_t));
+        memcpy(meta, col->meta, col->size);
+      }
+      free(col->lo), free(col->mid), free(col->hi), free(col->meta);
+      col->lo = lo, col->mid = mid, col->hi = hi, col->meta = meta;
+      if (capacity > col->capacity) col->capacity = capacity;
+    }
+  }
+  return rez;
+}
+
+/**
+ * @brief Добавление числа в конец колонки, память растет вдвое
+ *
+ * @param col указатель на колонку
+ * @param value число децимал со степенью не больше 28
+ * @param Владимир
+ * @return int 0 - OK, 1 - ошибка
+ */
+int s21_column_append(s21_decimal_column *col, s21_decimal value) {
+  int rez = s21_scale(value) > MAXEXP ? ERROR : OK;
+  if (rez == OK && col->size == col->capacity)
+    rez = s21_column_reserve(col, col->capacity ? 2 * col->capacity : 16);
+  if (rez == OK) {
+    col->size++;
+    s21_column_set(col, col->size - 1, value);
+  }
+  return rez;
+}
+
+/**
+ * @brief Чтение элемента колонки
+ *
+ * @param col указатель на колонку
+ * @param i номер элемента
+ * @param value указатель на число децимал для результата
+ * @param Владимир
+ * @return int 0 - OK, 1 - номер за пределами колонки
+ */
+int s21_column_get(const s21_decimal_column *col, size_t i,
+                   s21_decimal *value) {
+  int rez = i < col->size ? OK : ERROR;
+  if (rez == OK) {
+    value->bits[0] = (int)col->lo[i];
+    value->bits[1] = (int)col->mid[i];
+    value->bits[2] = (int)col->hi[i];
+    value->bits[3] = (int)((uint32_t)(col->meta[i] & COLUMN_SCALE) << 16 |
+                           (uint32_t)(col->meta[i] >> 7) << 31);
+  }
+  return rez;
+}
+
+/**
+ * @brief Запись элемента колонки
+ *
+ * @param col указатель на колонку
+ * @param i номер элемента
+ * @param value число децимал со степенью не больше 28
+ * @param Владимир
+ * @return int 0 - OK, 1 - номер за пределами колонки или неверная степень
+ */
+int s21_column_set(s21_decimal_column *col, size_t i, s21_decimal value) {
+  int rez = i < col->size && s21_scale(value) <= MAXEXP ? OK : ERROR;
+  if (rez == OK) {
+    col->lo[i] = (uint32_t)value.bits[0];
+    col->mid[i] = (uint32_t)value.bits[1];
+    col->hi[i] = (uint32_t)value.bits[2];
+    col->meta[i] = s21_column_pack(value);
+  }
+  return rez;
+}
+
+/**
+ * @brief Срез колонки [begin, end) без копирования: срез ссылается на
+ * память колонки, не растет и действителен, пока колонка не изменит размер
+ * памяти
+ *
+ * @param col указатель на колонку
+ * @param begin первый элемент среза
+ * @param end элемент после последнего
+ * @param view указатель на колонку-срез
+ * @param Владимир
+ * @return int 0 - OK, 1 - границы за пределами колонки
+ */
+int s21_column_slice(const s21_decimal_column *col, size_t begin, size_t end,
+                     s21_decimal_column *view) {
+  int rez = begin <= end && end <= col->size ? OK : ERROR;
+  if (rez == OK) {
+    view->lo = col->lo + begin;
+    view->mid = col->mid + begin;
+    view->hi = col->hi + begin;
+    view->meta = col->meta + begin;
+    view->size = view->capacity = end - begin;
+    view->owner = FALSE;
+  }
+  return rez;
+}
+
+/**
+ * @brief Заполнение колонки из обычного массива, прежнее содержимое
+ * заменяется
+ *
+ * @param col указатель на колонку
+ * @param src массив чисел децимал
+ * @param n количество элементов
+ * @param Владимир
+ * @return int 0 - OK, 1 - ошибка памяти или неверная степень
+ */
+int s21_column_from_array(s21_decimal_column *col, const s21_decimal *src,
+                          size_t n) {
+  int rez = s21_column_reserve(col, n);
+  if (rez == OK) {
+    col->size = n;
+    for (size_t i = 0; i < n && rez == OK; i++)
+      rez = s21_column_set(col, i, src[i]);
+    if (rez) col->size = 0;
+  }
+  return rez;
+}
+
+/**
+ * @brief Копирование колонки в обычный массив
+ *
+ * @param col указатель на колонку
+ * @param dst массив не меньше col->size элементов
+ * @param Владимир
+ */
+void s21_column_to_array(const s21_decimal_column *col, s21_decimal *dst) {
+  for (size_t i = 0; i < col->size; i++) s21_column_get(col, i, &dst[i]);
+}
+
+/**
+ * @brief Поэлементная операция над массивами: out[i] = op(a[i], b[i * step]).
+ * Элементы читаются до записи результата, поэтому out может совпадать с a
+ * или b
+ *
+ * @param op операция над двумя числами Decimal
+ * @param a массив первых аргументов
+ * @param b массив вторых аргументов
+ * @param step шаг по b: 1 - массив, 0 - одно число для всех элементов
+ * @param out массив результатов
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_batch(s21_decimal_op op, const s21_decimal *a, const s21_decimal *b,
+              size_t step, s21_decimal *out, int *status, size_t n) {
+  int rez = OK;
+  for (size_t i = 0; i < n; i++) {
+    s21_decimal val_1 = a[i], val_2 = b[i * step], val = {{0, 0, 0, 0}};
+    int code = op(val_1, val_2, &val);
+    out[i] = val;
+    if (status) status[i] = code;
+    if (code && rez == OK) rez = code;
+  }
+  return rez;
+}
+
+/**
+ * @brief Поэлементное сложение массивов
+ *
+ * @param a массив первых слагаемых
+ * @param b массив вторых слагаемых
+ * @param out массив результатов, может совпадать с a или b
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_add_n(const s21_decimal *a, const s21_decimal *b, s21_decimal *out,
+              int *status, size_t n) {
+  return s21_batch(s21_add, a, b, 1, out, status, n);
+}
+
+/**
+ * @brief Поэлементное вычитание массивов
+ *
+ * @param a массив уменьшаемых
+ * @param b массив вычитаемых
+ * @param out массив результатов, может совпадать с a или b
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_sub_n(const s21_decimal *a, const s21_decimal *b, s21_decimal *out,
+              int *status, size_t n) {
+  return s21_batch(s21_sub, a, b, 1, out, status, n);
+}
+
+/**
+ * @brief Поэлементное умножение массивов
+ *
+ * @param a массив первых множителей
+ * @param b массив вторых множителей
+ * @param out массив результатов, может совпадать с a или b
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_mul_n(const s21_decimal *a, const s21_decimal *b, s21_decimal *out,
+              int *status, size_t n) {
+  return s21_batch(s21_mul, a, b, 1, out, status, n);
+}
+
+/**
+ * @brief Поэлементное деление массивов
+ *
+ * @param a массив делимых
+ * @param b массив делителей
+ * @param out массив результатов, может совпадать с a или b
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_div_n(const s21_decimal *a, const s21_decimal *b, s21_decimal *out,
+              int *status, size_t n) {
+  return s21_batch(s21_div, a, b, 1, out, status, n);
+}
+
+/**
+ * @brief Поэлементный остаток от деления массивов
+ *
+ * @param a массив делимых
+ * @param b массив делителей
+ * @param out массив результатов, может совпадать с a или b
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_mod_n(const s21_decimal *a, const s21_decimal *b, s21_decimal *out,
+              int *status, size_t n) {
+  return s21_batch(s21_mod, a, b, 1, out, status, n);
+}
+
+/**
+ * @brief Прибавление одного числа ко всем элементам массива
+ *
+ * @param a массив первых слагаемых
+ * @param b слагаемое для всех элементов
+ * @param out массив результатов, может совпадать с a
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_add_scalar_n(const s21_decimal *a, s21_decimal b, s21_decimal *out,
+                     int *status, size_t n) {
+  return s21_batch(s21_add, a, &b, 0, out, status, n);
+}
+
+/**
+ * @brief Вычитание одного числа из всех элементов массива
+ *
+ * @param a массив уменьшаемых
+ * @param b вычитаемое для всех элементов
+ * @param out массив результатов, может совпадать с a
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_sub_scalar_n(const s21_decimal *a, s21_decimal b, s21_decimal *out,
+                     int *status, size_t n) {
+  return s21_batch(s21_sub, a, &b, 0, out, status, n);
+}
+
+/**
+ * @brief Умножение всех элементов массива на одно число
+ *
+ * @param a массив первых множителей
+ * @param b множитель для всех элементов
+ * @param out массив результатов, может совпадать с a
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_mul_scalar_n(const s21_decimal *a, s21_decimal b, s21_decimal *out,
+                     int *status, size_t n) {
+  return s21_batch(s21_mul, a, &b, 0, out, status, n);
+}
+
+/**
+ * @brief Деление всех элементов массива на одно число
+ *
+ * @param a массив делимых
+ * @param b делитель для всех элементов
+ * @param out массив результатов, может совпадать с a
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_div_scalar_n(const s21_decimal *a, s21_decimal b, s21_decimal *out,
+                     int *status, size_t n) {
+  return s21_batch(s21_div, a, &b, 0, out, status, n);
+}
+
+/**
+ * @brief Остаток от деления всех элементов массива на одно число
+ *
+ * @param a массив делимых
+ * @param b делитель для всех элементов
+ * @param out массив результатов, может совпадать с a
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return int код ошибки первого неудачного элемента или OK
+ */
+int s21_mod_scalar_n(const s21_decimal *a, s21_decimal b, s21_decimal *out,
+                     int *status, size_t n) {
+  return s21_batch(s21_mod, a, &b, 0, out, status, n);
+}
+
+/**
+ * @brief Сложение или вычитание одного элемента колонок. При одинаковой
+ * степени мантиссы складываются как 96-битные целые, степень сохраняется.
+ * При разных степенях и при переносе за 96 бит используются s21_add и
+ * s21_sub с их округлением и кодами ошибок
+ *
+ * @param a указатель на колонку первых аргументов
+ * @param b указатель на колонку вторых аргументов
+ * @param out указатель на колонку результатов
+ * @param i номер элемента
+ * @param sub 0 - сложение, 1 - вычитание
+ * @param Владимир
+ * @return int код ошибки элемента
+ */
+int s21_column_lane(const s21_decimal_column *a, const s21_decimal_column *b,
+                    s21_decimal_column *out, size_t i, int sub) {
+  int rez = OK, done = FALSE, scale = a->meta[i] & COLUMN_SCALE;
+  if (scale == (b->meta[i] & COLUMN_SCALE)) {
+    uint64_t lo_a = a->lo[i] | (uint64_t)a->mid[i] << 32;
+    uint64_t lo_b = b->lo[i] | (uint64_t)b->mid[i] << 32, lo;
+    uint64_t hi_a = a->hi[i], hi_b = b->hi[i], hi;
+    int sign = a->meta[i] >> 7, sign_b = (b->meta[i] >> 7) ^ sub;
+    if (sign == sign_b) {
+      lo = lo_a + lo_b;
+      hi = hi_a + hi_b + (lo < lo_a);
+      done = !(hi >> 32);
+    } else {
+      lo = lo_a - lo_b;
+      hi = hi_a - hi_b - (lo_a < lo_b);
+      if (hi >> 32) {
+        lo = lo_b - lo_a;
+        hi = hi_b - hi_a - (lo_b < lo_a);
+        sign = sign_b;
+      }
+      done = TRUE;
+    }
+    if (done) {
+      out->lo[i] = (uint32_t)lo;
+      out->mid[i] = (uint32_t)(lo >> 32);
+      out->hi[i] = (uint32_t)hi;
+      out->meta[i] = (uint8_t)(scale | (lo || (uint32_t)hi ? sign << 7 : 0));
+    }
+  }
+  if (!done) {
+    s21_decimal val_1, val_2, val;
+    s21_column_get(a, i, &val_1);
+    s21_column_get(b, i, &val_2);
+    rez = sub ? s21_sub(val_1, val_2, &val) : s21_add(val_1, val_2, &val);
+    s21_column_set(out, i, val);
+  }
+  return rez;
+}
+
+#ifdef S21_X86_SIMD
+// x < y для беззнаковых 32-битных элементов: max(x, y) != x
+#define S21_LT_AVX2(x, y) \
+  _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(x, y), x), ones)
+
+/**
+ * @brief Ядро AVX2: по 8 элементов за шаг. Сумма и обе разности мантисс
+ * считаются с переносом по 32-битным словам, результат выбирается по знакам
+ * и заему. Элементы с разной степенью и с переносом за 96 бит считаются
+ * через s21_column_lane до записи векторного результата, поэтому out может
+ * совпадать с a или b
+ *
+ * @param a указатель на колонку первых аргументов
+ * @param b указатель на колонку вторых аргументов
+ * @param out указатель на колонку результатов
+ * @param status массив кодов ошибок или NULL
+ * @param sub 0 - сложение, 1 - вычитание
+ * @param rez указатель на код первой ошибки
+ * @param Владимир
+ * @return size_t количество обработанных элементов
+ */
+__attribute__((target("avx2"))) size_t s21_column_avx2(
+    const s21_decimal_column *a, const s21_decimal_column *b,
+    s21_decimal_column *out, int *status, int sub, int *rez) {
+  const __m256i ones = _mm256_set1_epi32(-1), zero = _mm256_setzero_si256();
+  const __m256i scale_mask = _mm256_set1_epi32(COLUMN_SCALE);
+  const __m256i sub_sign = _mm256_set1_epi32(sub ? 1 : 0);
+  size_t i = 0;
+  for (; i + 8 <= a->size; i += 8) {
+    __m256i a0 = _mm256_loadu_si256((const __m256i *)(a->lo + i));
+    __m256i a1 = _mm256_loadu_si256((const __m256i *)(a->mid + i));
+    __m256i a2 = _mm256_loadu_si256((const __m256i *)(a->hi + i));
+    __m256i b0 = _mm256_loadu_si256((const __m256i *)(b->lo + i));
+    __m256i b1 = _mm256_loadu_si256((const __m256i *)(b->mid + i));
+    __m256i b2 = _mm256_loadu_si256((const __m256i *)(b->hi + i));
+    __m256i meta_a =
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(a->meta + i)));
+    __m256i meta_b =
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(b->meta + i)));
+    __m256i scale = _mm256_and_si256(meta_a, scale_mask);
+    __m256i sign_a = _mm256_srli_epi32(meta_a, 7);
+    __m256i sign_b = _mm256_xor_si256(_mm256_srli_epi32(meta_b, 7), sub_sign);
+    __m256i same = _mm256_cmpeq_epi32(sign_a, sign_b);
+    // сумма модулей, перенос - маска из единиц
+    __m256i s0 = _mm256_add_epi32(a0, b0), c = S21_LT_AVX2(s0, a0);
+    __m256i t = _mm256_add_epi32(a1, b1), c1 = S21_LT_AVX2(t, a1);
+    __m256i s1 = _mm256_sub_epi32(t, c);
+    c = _mm256_or_si256(c1, S21_LT_AVX2(s1, t));
+    t = _mm256_add_epi32(a2, b2), c1 = S21_LT_AVX2(t, a2);
+    __m256i s2 = _mm256_sub_epi32(t, c);
+    __m256i carry = _mm256_or_si256(c1, S21_LT_AVX2(s2, t));
+    // a - b, заем - маска из единиц
+    __m256i d0 = _mm256_sub_epi32(a0, b0), w = S21_LT_AVX2(a0, b0);
+    t = _mm256_sub_epi32(a1, b1), c1 = S21_LT_AVX2(a1, b1);
+    __m256i d1 = _mm256_add_epi32(t, w);
+    w = _mm256_or_si256(c1, _mm256_and_si256(w, _mm256_cmpeq_epi32(t, zero)));
+    t = _mm256_sub_epi32(a2, b2), c1 = S21_LT_AVX2(a2, b2);
+    __m256i d2 = _mm256_add_epi32(t, w);
+    __m256i neg =
+        _mm256_or_si256(c1, _mm256_and_si256(w, _mm256_cmpeq_epi32(t, zero)));
+    // b - a
+    __m256i e0 = _mm256_sub_epi32(b0, a0);
+    w = S21_LT_AVX2(b0, a0);
+    t = _mm256_sub_epi32(b1, a1), c1 = S21_LT_AVX2(b1, a1);
+    __m256i e1 = _mm256_add_epi32(t, w);
+    w = _mm256_or_si256(c1, _mm256_and_si256(w, _mm256_cmpeq_epi32(t, zero)));
+    __m256i e2 = _mm256_add_epi32(_mm256_sub_epi32(b2, a2), w);
+    // выбор: сумма при равных знаках, иначе a - b или b - a
+    __m256i r0 = _mm256_blendv_epi8(_mm256_blendv_epi8(d0, e0, neg), s0, same);
+    __m256i r1 = _mm256_blendv_epi8(_mm256_blendv_epi8(d1, e1, neg), s1, same);
+    __m256i r2 = _mm256_blendv_epi8(_mm256_blendv_epi8(d2, e2, neg), s2, same);
+    __m256i sign = _mm256_blendv_epi8(sign_a, sign_b,
+                                      _mm256_andnot_si256(same, neg));
+    __m256i nonzero = _mm256_xor_si256(
+        _mm256_cmpeq_epi32(_mm256_or_si256(_mm256_or_si256(r0, r1), r2), zero),
+        ones);
+    __m256i meta = _mm256_or_si256(
+        scale, _mm256_slli_epi32(_mm256_and_si256(sign, nonzero), 7));
+    __m256i slow = _mm256_or_si256(
+        _mm256_xor_si256(
+            _mm256_cmpeq_epi32(scale, _mm256_and_si256(meta_b, scale_mask)),
+            ones),
+        _mm256_and_si256(same, carry));
+    int slow_bits = _mm256_movemask_ps(_mm256_castsi256_ps(slow));
+    for (int k = 0; k < 8; k++) {
+      int code = OK;
+      if (slow_bits >> k & 1) code = s21_column_lane(a, b, out, i + k, sub);
+      if (status) status[i + k] = code;
+      if (code && *rez == OK) *rez = code;
+    }
+    __m256i keep = _mm256_xor_si256(slow, ones);
+    _mm256_maskstore_epi32((int *)(out->lo + i), keep, r0);
+    _mm256_maskstore_epi32((int *)(out->mid + i), keep, r1);
+    _mm256_maskstore_epi32((int *)(out->hi + i), keep, r2);
+    uint32_t bytes[8];
+    _mm256_storeu_si256((__m256i *)bytes, meta);
+    for (int k = 0; k < 8; k++)
+      if (!(slow_bits >> k & 1)) out->meta[i + k] = (uint8_t)bytes[k];
+  }
+  return i;
+}
+#undef S21_LT_AVX2
+
+/**
+ * @brief Ядро AVX-512: по 16 элементов за шаг, то же, что s21_column_avx2,
+ * с масками сравнения вместо векторов из единиц
+ *
+ * @param a указатель на колонку первых аргументов
+ * @param b указатель на колонку вторых аргументов
+ * @param out указатель на колонку результатов
+ * @param status массив кодов ошибок или NULL
+ * @param sub 0 - сложение, 1 - вычитание
+ * @param rez указатель на код первой ошибки
+ * @param Владимир
+ * @return size_t количество обработанных элементов
+ */
+__attribute__((target("avx512f"))) size_t s21_column_avx512(
+    const s21_decimal_column *a, const s21_decimal_column *b,
+    s21_decimal_column *out, int *status, int sub, int *rez) {
+  const __m512i zero = _mm512_setzero_si512(), one = _mm512_set1_epi32(1);
+  const __m512i scale_mask = _mm512_set1_epi32(COLUMN_SCALE);
+  const __m512i sub_sign = _mm512_set1_epi32(sub ? 1 : 0);
+  size_t i = 0;
+  for (; i + 16 <= a->size; i += 16) {
+    __m512i a0 = _mm512_loadu_si512(a->lo + i);
+    __m512i a1 = _mm512_loadu_si512(a->mid + i);
+    __m512i a2 = _mm512_loadu_si512(a->hi + i);
+    __m512i b0 = _mm512_loadu_si512(b->lo + i);
+    __m512i b1 = _mm512_loadu_si512(b->mid + i);
+    __m512i b2 = _mm512_loadu_si512(b->hi + i);
+    __m512i meta_a =
+        _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(a->meta + i)));
+    __m512i meta_b =
+        _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(b->meta + i)));
+    __m512i scale = _mm512_and_si512(meta_a, scale_mask);
+    __m512i sign_a = _mm512_srli_epi32(meta_a, 7);
+    __m512i sign_b = _mm512_xor_si512(_mm512_srli_epi32(meta_b, 7), sub_sign);
+    __mmask16 same = _mm512_cmpeq_epi32_mask(sign_a, sign_b);
+    // сумма модулей
+    __m512i s0 = _mm512_add_epi32(a0, b0);
+    __mmask16 c = _mm512_cmplt_epu32_mask(s0, a0);
+    __m512i t = _mm512_add_epi32(a1, b1);
+    __mmask16 c1 = _mm512_cmplt_epu32_mask(t, a1);
+    __m512i s1 = _mm512_mask_add_epi32(t, c, t, one);
+    c = c1 | _mm512_cmplt_epu32_mask(s1, t);
+    t = _mm512_add_epi32(a2, b2), c1 = _mm512_cmplt_epu32_mask(t, a2);
+    __m512i s2 = _mm512_mask_add_epi32(t, c, t, one);
+    __mmask16 carry = c1 | _mm512_cmplt_epu32_mask(s2, t);
+    // a - b
+    __m512i d0 = _mm512_sub_epi32(a0, b0);
+    __mmask16 w = _mm512_cmplt_epu32_mask(a0, b0);
+    t = _mm512_sub_epi32(a1, b1), c1 = _mm512_cmplt_epu32_mask(a1, b1);
+    __m512i d1 = _mm512_mask_sub_epi32(t, w, t, one);
+    w = c1 | (w & _mm512_cmpeq_epi32_mask(t, zero));
+    t = _mm512_sub_epi32(a2, b2), c1 = _mm512_cmplt_epu32_mask(a2, b2);
+    __m512i d2 = _mm512_mask_sub_epi32(t, w, t, one);
+    __mmask16 neg = c1 | (w & _mm512_cmpeq_epi32_mask(t, zero));
+    // b - a
+    __m512i e0 = _mm512_sub_epi32(b0, a0);
+    w = _mm512_cmplt_epu32_mask(b0, a0);
+    t = _mm512_sub_epi32(b1, a1), c1 = _mm512_cmplt_epu32_mask(b1, a1);
+    __m512i e1 = _mm512_mask_sub_epi32(t, w, t, one);
+    w = c1 | (w & _mm512_cmpeq_epi32_mask(t, zero));
+    t = _mm512_sub_epi32(b2, a2);
+    __m512i e2 = _mm512_mask_sub_epi32(t, w, t, one);
+    // выбор: сумма при равных знаках, иначе a - b или b - a
+    __m512i r0 = _mm512_mask_blend_epi32(
+        same, _mm512_mask_blend_epi32(neg, d0, e0), s0);
+    __m512i r1 = _mm512_mask_blend_epi32(
+        same, _mm512_mask_blend_epi32(neg, d1, e1), s1);
+    __m512i r2 = _mm512_mask_blend_epi32(
+        same, _mm512_mask_blend_epi32(neg, d2, e2), s2);
+    __m512i sign = _mm512_mask_blend_epi32(~same & neg, sign_a, sign_b);
+    __mmask16 nonzero = _mm512_test_epi32_mask(
+        _mm512_or_si512(_mm512_or_si512(r0, r1), r2),
+        _mm512_set1_epi32(-1));
+    __m512i meta = _mm512_mask_or_epi32(scale, nonzero, scale,
+                                        _mm512_slli_epi32(sign, 7));
+    __mmask16 slow =
+        _mm512_cmpneq_epi32_mask(scale, _mm512_and_si512(meta_b, scale_mask)) |
+        (same & carry);
+    for (int k = 0; k < 16; k++) {
+      int code = OK;
+      if (slow >> k & 1) code = s21_column_lane(a, b, out, i + k, sub);
+      if (status) status[i + k] = code;
+      if (code && *rez == OK) *rez = code;
+    }
+    __mmask16 keep = ~slow;
+    _mm512_mask_storeu_epi32(out->lo + i, keep, r0);
+    _mm512_mask_storeu_epi32(out->mid + i, keep, r1);
+    _mm512_mask_storeu_epi32(out->hi + i, keep, r2);
+    _mm512_mask_cvtepi32_storeu_epi8(out->meta + i, keep, meta);
+  }
+  return i;
+}
+#endif
+
+/**
+ * @brief Ограничение уровня векторных ядер, например для проверки
+ * скалярного пути
+ *
+ * @param level SIMD_SCALAR, SIMD_AVX2 или SIMD_AVX512
+ * @param Владимир
+ */
+void s21_simd_limit(int level) { simd_limit = level; }
+
+/**
+ * @brief Уровень векторных ядер: поддержка процессора по cpuid с учетом
+ * ограничения s21_simd_limit
+ *
+ * @param Владимир
+ * @return int SIMD_SCALAR, SIMD_AVX2 или SIMD_AVX512
+ */
+int s21_simd_level(void) {
+  int level = SIMD_SCALAR;
+#ifdef S21_X86_SIMD
+  if (__builtin_cpu_supports("avx512f"))
+    level = SIMD_AVX512;
+  else if (__builtin_cpu_supports("avx2"))
+    level = SIMD_AVX2;
+#endif
+  return level < simd_limit ? level : simd_limit;
+}
+
+/**
+ * @brief Поэлементное сложение или вычитание колонок одного размера
+ *
+ * @param a указатель на колонку первых аргументов
+ * @param b указатель на колонку вторых аргументов
+ * @param out указатель на колонку результатов, может совпадать с a или b
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param sub 0 - сложение, 1 - вычитание
+ * @param Владимир
+ * @return int ERROR при разных размерах или ошибке памяти, иначе код первой
+ * ошибки элемента или OK
+ */
+int s21_column_op(const s21_decimal_column *a, const s21_decimal_column *b,
+                  s21_decimal_column *out, int *status, int sub) {
+  int rez = a->size == b->size ? OK : ERROR;
+  if (rez == OK && out->capacity < a->size)
+    rez = s21_column_reserve(out, a->size);
+  if (rez == OK) {
+    size_t i = 0;
+    out->size = a->size;
+#ifdef S21_X86_SIMD
+    int level = s21_simd_level();
+    if (level == SIMD_AVX512)
+      i = s21_column_avx512(a, b, out, status, sub, &rez);
+    else if (level == SIMD_AVX2)
+      i = s21_column_avx2(a, b, out, status, sub, &rez);
+#endif
+    for (; i < a->size; i++) {
+      int code = s21_column_lane(a, b, out, i, sub);
+      if (status) status[i] = code;
+      if (code && rez == OK) rez = code;
+    }
+  }
+  return rez;
+}
+
+/**
+ * @brief Поэлементное сложение колонок
+ *
+ * @param a указатель на колонку первых слагаемых
+ * @param b указатель на колонку вторых слагаемых
+ * @param out указатель на колонку результатов, может совпадать с a или b
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param Владимир
+ * @return int ERROR при разных размерах или ошибке памяти, иначе код первой
+ * ошибки элемента или OK
+ */
+int s21_column_add(const s21_decimal_column *a, const s21_decimal_column *b,
+                   s21_decimal_column *out, int *status) {
+  return s21_column_op(a, b, out, status, 0);
+}
+
+/**
+ * @brief Поэлементное вычитание колонок
+ *
+ * @param a указатель на колонку уменьшаемых
+ * @param b указатель на колонку вычитаемых
+ * @param out указатель на колонку результатов, может совпадать с a или b
+ * @param status массив кодов ошибок для каждого элемента или NULL
+ * @param Владимир
+ * @return int ERROR при разных размерах или ошибке памяти, иначе код первой
+ * ошибки элемента или OK
+ */
+int s21_column_sub(const s21_decimal_column *a, const s21_decimal_column *b,
+                   s21_decimal_column *out, int *status) {
+  return s21_column_op(a, b, out, status, 1);
+}
+
+/**
+ * @brief Проверка элемента по битовой маске значимых элементов: бит i % 8
+ * байта i / 8, маска NULL означает, что значимы все элементы
+ *
+ * @param valid битовая маска или NULL
+ * @param i номер элемента
+ * @param Владимир
+ * @return int 0 - FALSE, 1 - TRUE
+ */
+int s21_valid(const uint8_t *valid, size_t i) {
+  return !valid || (valid[i >> 3] >> (i & 7) & 1);
+}
+
+/**
+ * @brief Количество значимых элементов по битовой маске
+ *
+ * @param valid битовая маска или NULL
+ * @param n количество элементов
+ * @param Владимир
+ * @return size_t количество единичных битов среди первых n
+ */
+size_t s21_count(const uint8_t *valid, size_t n) {
+  size_t count = n;
+  if (valid) {
+    size_t i = 0;
+    count = 0;
+    for (; i + 64 <= n; i += 64) {
+      uint64_t word;
+      memcpy(&word, valid + i / 8, sizeof(word));
+      count += (size_t)__builtin_popcountll(word);
+    }
+    for (; i < n; i++) count += (size_t)s21_valid(valid, i);
+  }
+  return count;
+}
+
+/**
+ * @brief Прибавление мантиссы со знаком к 128-битной частичной сумме в
+ * дополнительном коде, без ветвлений по знаку
+ *
+ * @param sum младшее и старшее слово частичной суммы
+ * @param lo младшие 64 бита мантиссы
+ * @param hi старшие 32 бита мантиссы
+ * @param sign знак слагаемого: 0 - плюс, 1 - минус
+ * @param Владимир
+ */
+void s21_wide_add(uint64_t *sum, uint64_t lo, uint32_t hi, int sign) {
+  uint64_t mask = -(uint64_t)sign;
+  uint64_t add_lo = (lo ^ mask) - mask;
+  uint64_t add_hi = ((uint64_t)hi ^ mask) + (mask & !lo);
+  sum[0] += add_lo;
+  sum[1] += add_hi + (sum[0] < add_lo);
+}
+
+/**
+ * @brief Перенос частичных сумм по степеням в сумматор
+ *
+ * @param acc указатель на сумматор
+ * @param sums частичные суммы для степеней от 0 до MAXEXP
+ * @param used маска ненулевых частичных сумм
+ * @param Владимир
+ */
+void s21_wide_flush(s21_accumulator *acc, uint64_t (*sums)[2],
+                    uint32_t used) {
+  for (int scale = 0; scale <= MAXEXP; scale++) {
+    if (!(used >> scale & 1u)) continue;
+    uint64_t lo = sums[scale][0], hi = sums[scale][1];
+    int sign = hi >> 63;
+    if (sign) {
+      hi = ~hi + !lo;
+      lo = -lo;
+    }
+    s21_big_decimal big = {{(uint32_t)lo, (uint32_t)(lo >> 32), (uint32_t)hi,
+                            (uint32_t)(hi >> 32)}};
+    s21_acc_add_big(acc, &big, scale, sign);
+  }
+}
+
+/**
+ * @brief Прибавление значимых элементов массива к сумматору. Мантиссы
+ * складываются в 128-битные частичные суммы по степеням, блок из
+ * WIDE_BLOCK элементов не переполняет их
+ *
+ * @param acc указатель на сумматор
+ * @param src массив слагаемых
+ * @param valid битовая маска значимых элементов или NULL
+ * @param n количество элементов
+ * @param Владимир
+ */
+void s21_acc_array(s21_accumulator *acc, const s21_decimal *src,
+                   const uint8_t *valid, size_t n) {
+  for (size_t begin = 0; begin < n; begin += WIDE_BLOCK) {
+    size_t end = n - begin > WIDE_BLOCK ? begin + WIDE_BLOCK : n;
+    uint64_t sums[MAXEXP + 1][2] = {{0}}, run[2] = {0, 0};
+    uint32_t used = 0;
+    int last = 0;
+    for (size_t i = begin; i < end; i++) {
+      if (!s21_valid(valid, i)) continue;
+      uint32_t meta = (uint32_t)src[i].bits[3];
+      int scale = meta >> 16 & 0xff;
+      if (scale > MAXEXP) {
+        s21_acc_add(acc, src[i]);
+        continue;
+      }
+      if (scale != last) {
+        // сумма подряд идущих элементов одной степени держится в регистрах
+        s21_wide_add(sums[last], run[0], 0, 0);
+        sums[last][1] += run[1];
+        run[0] = run[1] = 0;
+        last = scale;
+      }
+      s21_wide_add(run,
+                   (uint32_t)src[i].bits[0] |
+                       (uint64_t)(uint32_t)src[i].bits[1] << 32,
+                   (uint32_t)src[i].bits[2], meta >> 31);
+      used |= 1u << scale;
+    }
+    s21_wide_add(sums[last], run[0], 0, 0);
+    sums[last][1] += run[1];
+    s21_wide_flush(acc, sums, used);
+  }
+}
+
+#ifdef S21_X86_SIMD
+/**
+ * @brief Ядро AVX2 для s21_acc_chunk: по 8 элементов за шаг, слова мантисс
+ * расширяются до 64 бит и меняют знак по маске
+ *
+ * @param col указатель на колонку слагаемых
+ * @param begin номер первого элемента куска
+ * @param end номер элемента за последним
+ * @param sums суммы младших, средних и старших слов, дополняются
+ * @param Владимир
+ * @return size_t номер первого необработанного элемента
+ */
+__attribute__((target("avx2"))) size_t s21_chunk_avx2(
+    const s21_decimal_column *col, size_t begin, size_t end, int64_t *sums) {
+  __m256i acc[6];
+  for (int k = 0; k < 6; k++) acc[k] = _mm256_setzero_si256();
+  const uint32_t *words[3] = {col->lo, col->mid, col->hi};
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    __m128i meta = _mm_loadl_epi64((const __m128i *)(col->meta + i));
+    __m128i meta_hi = _mm_srli_si128(meta, 4);
+    __m256i mask[2] = {_mm256_cvtepu8_epi64(meta),
+                       _mm256_cvtepu8_epi64(meta_hi)};
+    for (int h = 0; h < 2; h++)
+      mask[h] = _mm256_sub_epi64(_mm256_setzero_si256(),
+                                 _mm256_srli_epi64(mask[h], 7));
+    for (int k = 0; k < 3; k++) {
+      __m256i word = _mm256_loadu_si256((const __m256i *)(words[k] + i));
+      for (int h = 0; h < 2; h++) {
+        __m256i part = _mm256_cvtepu32_epi64(
+            h ? _mm256_extracti128_si256(word, 1)
+              : _mm256_castsi256_si128(word));
+        part = _mm256_sub_epi64(_mm256_xor_si256(part, mask[h]), mask[h]);
+        acc[2 * k + h] = _mm256_add_epi64(acc[2 * k + h], part);
+      }
+    }
+  }
+  for (int k = 0; k < 3; k++) {
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes,
+                        _mm256_add_epi64(acc[2 * k], acc[2 * k + 1]));
+    sums[k] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  }
+  return i;
+}
+#endif
+
+/**
+ * @brief Сумма куска колонки с одной степенью: слова мантисс со знаком
+ * складываются в отдельные 64-битные суммы, при поддержке AVX2 векторно
+ *
+ * @param acc указатель на сумматор
+ * @param col указатель на колонку слагаемых
+ * @param begin номер первого элемента куска
+ * @param end номер элемента за последним
+ * @param Владимир
+ */
+void s21_acc_chunk(s21_accumulator *acc, const s21_decimal_column *col,
+                   size_t begin, size_t end) {
+  int64_t sums[3] = {0, 0, 0};
+  size_t i = begin;
+#ifdef S21_X86_SIMD
+  if (s21_simd_level() >= SIMD_AVX2) i = s21_chunk_avx2(col, begin, end, sums);
+#endif
+  for (; i < end; i++) {
+    int64_t mask = -(int64_t)(col->meta[i] >> 7);
+    sums[0] += ((int64_t)col->lo[i] ^ mask) - mask;
+    sums[1] += ((int64_t)col->mid[i] ^ mask) - mask;
+    sums[2] += ((int64_t)col->hi[i] ^ mask) - mask;
+  }
+  // sums[0] + sums[1] * 2^32 + sums[2] * 2^64 в дополнительном коде
+  s21_big_decimal big = {{0}};
+  for (int k = 0; k < 3; k++) {
+    s21_big_decimal part = {{0}};
+    uint32_t fill = sums[k] < 0 ? MAXBITS : 0;
+    part.bits[k] = (uint32_t)sums[k];
+    part.bits[k + 1] = (uint32_t)((uint64_t)sums[k] >> 32);
+    for (int j = k + 2; j < BIG_LIMBS; j++) part.bits[j] = fill;
+    s21_big_add(&big, &part, &big);
+  }
+  s21_big_decimal *bucket =
+      s21_acc_bucket(acc, col->meta[begin] & COLUMN_SCALE);
+  s21_big_add(bucket, &big, bucket);
+}
+
+/**
+ * @brief Прибавление значимых элементов колонки к сумматору. Куски по
+ * COLUMN_CHUNK элементов без пропусков и с одной степенью считаются через
+ * s21_acc_chunk, остальные так же как в s21_acc_array
+ *
+ * @param acc указатель на сумматор
+ * @param col указатель на колонку слагаемых
+ * @param valid битовая маска значимых элементов или NULL
+ * @param Владимир
+ */
+void s21_acc_column(s21_accumulator *acc, const s21_decimal_column *col,
+                    const uint8_t *valid) {
+  for (size_t begin = 0; begin < col->size; begin += COLUMN_CHUNK) {
+    size_t end =
+        col->size - begin > COLUMN_CHUNK ? begin + COLUMN_CHUNK : col->size;
+    // степени куска совпадают, если в них равны И и ИЛИ всех байтов
+    uint64_t all = ~0ULL, any = 0;
+    uint8_t bits = 0xff;
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+      uint64_t word;
+      memcpy(&word, col->meta + i, sizeof(word));
+      all &= word, any |= word;
+    }
+    for (; i < end; i++)
+      all &= col->meta[i] * 0x0101010101010101ULL, any |= col->meta[i];
+    for (int k = 32; k >= 8; k >>= 1) all &= all >> k, any |= any >> k;
+    for (i = begin / 8; valid && i < (end + 7) / 8; i++)
+      bits &= i < end / 8 ? valid[i] : valid[i] | (0xff << (end & 7));
+    if ((all ^ any) & COLUMN_SCALE || bits != 0xff) {
+      uint64_t sums[MAXEXP + 1][2] = {{0}};
+      uint32_t used = 0;
+      for (size_t i = begin; i < end; i++) {
+        if (!s21_valid(valid, i)) continue;
+        int scale = col->meta[i] & COLUMN_SCALE;
+        s21_wide_add(sums[scale], col->lo[i] | (uint64_t)col->mid[i] << 32,
+                     col->hi[i], col->meta[i] >> 7);
+        used |= 1u << scale;
+      }
+      s21_wide_flush(acc, sums, used);
+    } else {
+      s21_acc_chunk(acc, col, begin, end);
+    }
+  }
+}
+
+/**
+ * @brief Точная сумма значимых элементов массива с одним округлением
+ *
+ * @param src массив слагаемых
+ * @param valid битовая маска значимых элементов или NULL
+ * @param n количество элементов
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки
+ */
+int s21_sum(const s21_decimal *src, const uint8_t *valid, size_t n,
+            s21_decimal *result) {
+  s21_accumulator acc;
+  s21_acc_init(&acc);
+  s21_acc_array(&acc, src, valid, n);
+  return s21_acc_finalize(&acc, result);
+}
+
+/**
+ * @brief Среднее значимых элементов массива: точная сумма и одно деление
+ *
+ * @param src массив чисел
+ * @param valid битовая маска значимых элементов или NULL
+ * @param n количество элементов
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_mean(const s21_decimal *src, const uint8_t *valid, size_t n,
+             s21_decimal *result) {
+  s21_accumulator acc;
+  s21_acc_init(&acc);
+  s21_acc_array(&acc, src, valid, n);
+  return s21_acc_mean(&acc, s21_count(valid, n), result);
+}
+
+/**
+ * @brief Учет элемента в лучших по ключу кандидатах: на каждую пару знака и
+ * степени хранится наибольший ключ и номер первого элемента с ним
+ *
+ * @param key ключи кандидатов: младшие 64 и старшие 32 бита
+ * @param pos номера кандидатов, SIZE_MAX у пустых
+ * @param slot пара знака и степени элемента
+ * @param lo младшие 64 бита ключа элемента
+ * @param hi старшие 32 бита ключа элемента
+ * @param i номер элемента
+ * @param Владимир
+ */
+void s21_extreme_slot(uint64_t (*key)[2], size_t *pos, int slot, uint64_t lo,
+                      uint64_t hi, size_t i) {
+  int better = hi > key[slot][1] || (hi == key[slot][1] && lo > key[slot][0]);
+  if (better || pos[slot] == SIZE_MAX) {
+    key[slot][0] = lo, key[slot][1] = hi;
+    pos[slot] = i;
+  }
+}
+
+/**
+ * @brief Поиск наименьшего или наибольшего значимого элемента массива.
+ * Внутри каждой пары знака и степени числа упорядочены по мантиссе, поэтому
+ * за один проход выбирается лучшая мантисса для каждой пары, а кандидаты
+ * сравниваются через s21_compare. Из равных остается первый
+ *
+ * @param src массив чисел
+ * @param valid битовая маска значимых элементов или NULL
+ * @param n количество элементов
+ * @param dir -1 - наименьший, 1 - наибольший
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_extreme(const s21_decimal *src, const uint8_t *valid, size_t n,
+                int dir, s21_decimal *result) {
+  uint64_t key[2 * (COLUMN_SCALE + 1)][2] = {{0}};
+  size_t pos[2 * (COLUMN_SCALE + 1)], best = SIZE_MAX;
+  for (int slot = 0; slot < 2 * (COLUMN_SCALE + 1); slot++)
+    pos[slot] = SIZE_MAX;
+  for (size_t i = 0; i < n; i++) {
+    if (!s21_valid(valid, i)) continue;
+    uint32_t meta = (uint32_t)src[i].bits[3];
+    int sign = meta >> 31, slot = (meta >> 16 & COLUMN_SCALE) | sign << 5;
+    // у отрицательных и при поиске наименьшего лучше меньшая мантисса
+    uint64_t flip = -(uint64_t)(sign ^ (dir < 0));
+    uint64_t lo = (uint32_t)src[i].bits[0] |
+                  (uint64_t)(uint32_t)src[i].bits[1] << 32;
+    s21_extreme_slot(key, pos, slot, lo ^ flip,
+                     ((uint32_t)src[i].bits[2] ^ flip) & MAXBITS, i);
+  }
+  for (int slot = 0; slot < 2 * (COLUMN_SCALE + 1); slot++) {
+    if (pos[slot] == SIZE_MAX) continue;
+    int rez = best == SIZE_MAX ? dir : s21_compare(src[pos[slot]], src[best]);
+    if (rez == dir || (rez == 0 && pos[slot] < best)) best = pos[slot];
+  }
+  *result = best != SIZE_MAX ? src[best] : (s21_decimal){{0, 0, 0, 0}};
+  return best != SIZE_MAX ? OK : s21_NAN;
+}
+
+/**
+ * @brief Наименьший значимый элемент массива
+ *
+ * @param src массив чисел
+ * @param valid битовая маска значимых элементов или NULL
+ * @param n количество элементов
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_min(const s21_decimal *src, const uint8_t *valid, size_t n,
+            s21_decimal *result) {
+  return s21_extreme(src, valid, n, -1, result);
+}
+
+/**
+ * @brief Наибольший значимый элемент массива
+ *
+ * @param src массив чисел
+ * @param valid битовая маска значимых элементов или NULL
+ * @param n количество элементов
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_max(const s21_decimal *src, const uint8_t *valid, size_t n,
+            s21_decimal *result) {
+  return s21_extreme(src, valid, n, 1, result);
+}
+
+/**
+ * @brief Точная сумма значимых элементов колонки с одним округлением
+ *
+ * @param col указатель на колонку слагаемых
+ * @param valid битовая маска значимых элементов или NULL
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки
+ */
+int s21_column_sum(const s21_decimal_column *col, const uint8_t *valid,
+                   s21_decimal *result) {
+  s21_accumulator acc;
+  s21_acc_init(&acc);
+  s21_acc_column(&acc, col, valid);
+  return s21_acc_finalize(&acc, result);
+}
+
+/**
+ * @brief Среднее значимых элементов колонки: точная сумма и одно деление
+ *
+ * @param col указатель на колонку
+ * @param valid битовая маска значимых элементов или NULL
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_column_mean(const s21_decimal_column *col, const uint8_t *valid,
+                    s21_decimal *result) {
+  s21_accumulator acc;
+  s21_acc_init(&acc);
+  s21_acc_column(&acc, col, valid);
+  return s21_acc_mean(&acc, s21_count(valid, col->size), result);
+}
+
+/**
+ * @brief Поиск наименьшего или наибольшего значимого элемента колонки, так
+ * же как s21_extreme
+ *
+ * @param col указатель на колонку
+ * @param valid битовая маска значимых элементов или NULL
+ * @param dir -1 - наименьший, 1 - наибольший
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_column_extreme(const s21_decimal_column *col, const uint8_t *valid,
+                       int dir, s21_decimal *result) {
+  uint64_t key[2 * (COLUMN_SCALE + 1)][2] = {{0}};
+  size_t pos[2 * (COLUMN_SCALE + 1)], best = SIZE_MAX;
+  for (int slot = 0; slot < 2 * (COLUMN_SCALE + 1); slot++)
+    pos[slot] = SIZE_MAX;
+  for (size_t i = 0; i < col->size; i++) {
+    if (!s21_valid(valid, i)) continue;
+    int sign = col->meta[i] >> 7;
+    uint64_t flip = -(uint64_t)(sign ^ (dir < 0));
+    s21_extreme_slot(key, pos, (col->meta[i] & COLUMN_SCALE) | sign << 5,
+                     (col->lo[i] | (uint64_t)col->mid[i] << 32) ^ flip,
+                     (col->hi[i] ^ flip) & MAXBITS, i);
+  }
+  s21_decimal value, other;
+  for (int slot = 0; slot < 2 * (COLUMN_SCALE + 1); slot++) {
+    if (pos[slot] == SIZE_MAX) continue;
+    int rez = dir;
+    if (best != SIZE_MAX) {
+      s21_column_get(col, pos[slot], &value);
+      s21_column_get(col, best, &other);
+      rez = s21_compare(value, other);
+    }
+    if (rez == dir || (rez == 0 && pos[slot] < best)) best = pos[slot];
+  }
+  *result = (s21_decimal){{0, 0, 0, 0}};
+  return s21_column_get(col, best, result) == OK ? OK : s21_NAN;
+}
+
+/**
+ * @brief Наименьший значимый элемент колонки
+ *
+ * @param col указатель на колонку
+ * @param valid битовая маска значимых элементов или NULL
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_column_min(const s21_decimal_column *col, const uint8_t *valid,
+                   s21_decimal *result) {
+  return s21_column_extreme(col, valid, -1, result);
+}
+
+/**
+ * @brief Наибольший значимый элемент колонки
+ *
+ * @param col указатель на колонку
+ * @param valid битовая маска значимых элементов или NULL
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_column_max(const s21_decimal_column *col, const uint8_t *valid,
+                   s21_decimal *result) {
+  return s21_column_extreme(col, valid, 1, result);
+}
+
+/**
+ * @brief Ключ сортировки: мантисса, приведенная к общей степени top, плюс
+ * 2^191. Модуль меньше 2^190, поэтому беззнаковый порядок ключей совпадает
+ * с порядком чисел, а -0 и +0, 1.0 и 1.00 получают одинаковые ключи
+ *
+ * @param lo младшее слово мантиссы
+ * @param mid среднее слово мантиссы
+ * @param hi старшее слово мантиссы
+ * @param meta байт знака и степени, как в колонке
+ * @param top общая степень, не меньше степени числа
+ * @param key ключ: три 64-битных слова от младшего
+ * @param Владимир
+ */
+void s21_sort_key(uint32_t lo, uint32_t mid, uint32_t hi, uint8_t meta,
+                  int top, uint64_t *key) {
+  int scale = meta & COLUMN_SCALE;
+  const uint32_t *pow = pow10_bits[scale < top ? top - scale : 0];
+  uint32_t mant[3] = {lo, mid, hi}, prod[6] = {0};
+  for (int i = 0; i < 3; i++) {
+    uint64_t carry = 0;
+    for (int j = 0; j < 3; j++) {
+      carry += (uint64_t)mant[i] * pow[j] + prod[i + j];
+      prod[i + j] = (uint32_t)carry;
+      carry >>= 32;
+    }
+    prod[i + 3] = (uint32_t)carry;
+  }
+  for (int i = 0; i < 3; i++)
+    key[i] = prod[2 * i] | (uint64_t)prod[2 * i + 1] << 32;
+  if (meta >> 7) {
+    // дополнительный код модуля
+    key[0] = ~key[0] + 1;
+    key[1] = ~key[1] + !key[0];
+    key[2] = ~key[2] + (!key[0] && !key[1]);
+  }
+  key[2] ^= 1ULL << 63;
+}
+
+/**
+ * @brief Поразрядная сортировка ключей по 8-битным цифрам от младшей.
+ * Разряды с одной цифрой у всех ключей пропускаются, количества цифр
+ * остальных считаются за один проход. Сортировка устойчива
+ *
+ * @param item массив ключей с номерами
+ * @param n количество ключей
+ * @param Владимир
+ * @return int ERROR при ошибке памяти, иначе OK
+ */
+int s21_radix_sort(s21_sort_item *item, size_t n) {
+  s21_sort_item *temp = malloc(n ? n * sizeof(s21_sort_item) : 1);
+  size_t(*count)[256] = calloc(SORT_DIGITS, sizeof(*count));
+  int rez = temp && count ? OK : ERROR;
+  if (rez == OK && n > 1) {
+    // разряды, в которых ключи отличаются от первого
+    uint64_t diff[3] = {0, 0, 0};
+    for (size_t i = 1; i < n; i++)
+      for (int w = 0; w < 3; w++) diff[w] |= item[i].key[w] ^ item[0].key[w];
+    int digit[SORT_DIGITS], digits = 0;
+    for (int d = 0; d < SORT_DIGITS; d++)
+      if (diff[d / 8] >> (d % 8 * 8) & 0xff) digit[digits++] = d;
+    for (size_t i = 0; i < n; i++)
+      for (int k = 0; k < digits; k++) {
+        int d = digit[k];
+        count[d][item[i].key[d / 8] >> (d % 8 * 8) & 0xff]++;
+      }
+    s21_sort_item *from = item, *to = temp;
+    for (int k = 0; k < digits; k++) {
+      int d = digit[k], shift = d % 8 * 8, word = d / 8;
+      size_t pos = 0;
+      for (int k = 0; k < 256; k++) {
+        size_t num = count[d][k];
+        count[d][k] = pos;
+        pos += num;
+      }
+      for (size_t i = 0; i < n; i++)
+        to[count[d][from[i].key[word] >> shift & 0xff]++] = from[i];
+      s21_sort_item *swap = from;
+      from = to, to = swap;
+    }
+    if (from != item) memcpy(item, from, n * sizeof(s21_sort_item));
+  }
+  free(temp);
+  free(count);
+  return rez;
+}
+
+/**
+ * @brief Устойчивая сортировка номеров элементов массива по возрастанию
+ *
+ * @param src массив чисел
+ * @param n количество элементов
+ * @param perm номера: src[perm[0]] <= src[perm[1]] <= ...
+ * @param Владимир
+ * @return int ERROR при ошибке памяти, иначе OK
+ */
+int s21_sort_index(const s21_decimal *src, size_t n, size_t *perm) {
+  s21_sort_item *item = malloc(n ? n * sizeof(s21_sort_item) : 1);
+  int rez = item ? OK : ERROR;
+  if (rez == OK) {
+    // общая степень - наибольшая, чтобы ключи были как можно короче
+    int top = 0;
+    for (size_t i = 0; i < n; i++)
+      if (s21_scale(src[i]) > top) top = s21_scale(src[i]);
+    for (size_t i = 0; i < n; i++) {
+      s21_sort_key((uint32_t)src[i].bits[0], (uint32_t)src[i].bits[1],
+                   (uint32_t)src[i].bits[2], s21_column_pack(src[i]),
+                   top > MAXEXP ? MAXEXP : top, item[i].key);
+      item[i].index = i;
+    }
+    rez = s21_radix_sort(item, n);
+    for (size_t i = 0; i < n && rez == OK; i++) perm[i] = item[i].index;
+  }
+  free(item);
+  return rez;
+}
+
+/**
+ * @brief Устойчивая сортировка массива по возрастанию
+ *
+ * @param src массив чисел
+ * @param n количество элементов
+ * @param Владимир
+ * @return int ERROR при ошибке памяти, иначе OK
+ */
+int s21_sort(s21_decimal *src, size_t n) {
+  size_t *perm = malloc(n ? n * sizeof(size_t) : 1);
+  s21_decimal *copy = malloc(n ? n * sizeof(s21_decimal) : 1);
+  int rez = perm && copy ? s21_sort_index(src, n, perm) : ERROR;
+  if (rez == OK) {
+    memcpy(copy, src, n * sizeof(s21_decimal));
+    for (size_t i = 0; i < n; i++) src[i] = copy[perm[i]];
+  }
+  free(perm);
+  free(copy);
+  return rez;
+}
+
+/**
+ * @brief Устойчивая сортировка номеров элементов колонки по возрастанию
+ *
+ * @param col указатель на колонку
+ * @param perm номера элементов в порядке возрастания
+ * @param Владимир
+ * @return int ERROR при ошибке памяти, иначе OK
+ */
+int s21_column_sort_index(const s21_decimal_column *col, size_t *perm) {
+  size_t n = col->size;
+  s21_sort_item *item = malloc(n ? n * sizeof(s21_sort_item) : 1);
+  int rez = item ? OK : ERROR;
+  if (rez == OK) {
+    int top = 0;
+    for (size_t i = 0; i < n; i++)
+      if ((col->meta[i] & COLUMN_SCALE) > top)
+        top = col->meta[i] & COLUMN_SCALE;
+    for (size_t i = 0; i < n; i++) {
+      s21_sort_key(col->lo[i], col->mid[i], col->hi[i], col->meta[i], top,
+                   item[i].key);
+      item[i].index = i;
+    }
+    rez = s21_radix_sort(item, n);
+    for (size_t i = 0; i < n && rez == OK; i++) perm[i] = item[i].index;
+  }
+  free(item);
+  return rez;
+}
@@ -1,12 +1,85 @@
 #include "s21_decimal.h"
 
+#include <float.h>
 #include <math.h>
+#include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#define S21_X86_SIMD
+#include <immintrin.h>
+#endif
+
 const s21_decimal dec_null = {{0, 0, 0, 0}};
+// счетчики быстрого пути, общие для всех потоков
+static atomic_ullong fast_hits, fast_misses;
+// 10^0..10^19 в 64-битных словах
+const uint64_t pow10_u64[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+    1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL};
+// 10^0..10^22 - все степени 10, точно представимые в double
+const double pow10_dbl[23] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                              1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                              1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+// 00..99 подряд: цифры числа k < 100 - символы 2k и 2k + 1
+const char digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+// 10^0..10^9 для деления умножением на обратное: сдвиг нормализации,
+// нормализованный делитель d и обратное значение floor((2^64 - 1) / d) - 2^32
+const uint32_t pow10_recip[10][3] = {
+    {31, 0x80000000U, 0xffffffffU},  // 10^0
+    {28, 0xa0000000U, 0x99999999U},  // 10^1
+    {25, 0xc8000000U, 0x47ae147aU},  // 10^2
+    {22, 0xfa000000U, 0x0624dd2fU},  // 10^3
+    {18, 0x9c400000U, 0xa36e2eb1U},  // 10^4
+    {15, 0xc3500000U, 0x4f8b588eU},  // 10^5
+    {12, 0xf4240000U, 0x0c6f7a0bU},  // 10^6
+    {8, 0x98968000U, 0xad7f29abU},  // 10^7
+    {5, 0xbebc2000U, 0x5798ee23U},  // 10^8
+    {2, 0xee6b2800U, 0x12e0be82U},  // 10^9
+};
+// 10^0..10^28 в 96-битных мантиссах: младшее, среднее и старшее слово
+const uint32_t pow10_bits[MAXEXP + 1][3] = {
+    {0x00000001U, 0x00000000U, 0x00000000U},  // 10^0
+    {0x0000000aU, 0x00000000U, 0x00000000U},  // 10^1
+    {0x00000064U, 0x00000000U, 0x00000000U},  // 10^2
+    {0x000003e8U, 0x00000000U, 0x00000000U},  // 10^3
+    {0x00002710U, 0x00000000U, 0x00000000U},  // 10^4
+    {0x000186a0U, 0x00000000U, 0x00000000U},  // 10^5
+    {0x000f4240U, 0x00000000U, 0x00000000U},  // 10^6
+    {0x00989680U, 0x00000000U, 0x00000000U},  // 10^7
+    {0x05f5e100U, 0x00000000U, 0x00000000U},  // 10^8
+    {0x3b9aca00U, 0x00000000U, 0x00000000U},  // 10^9
+    {0x540be400U, 0x00000002U, 0x00000000U},  // 10^10
+    {0x4876e800U, 0x00000017U, 0x00000000U},  // 10^11
+    {0xd4a51000U, 0x000000e8U, 0x00000000U},  // 10^12
+    {0x4e72a000U, 0x00000918U, 0x00000000U},  // 10^13
+    {0x107a4000U, 0x00005af3U, 0x00000000U},  // 10^14
+    {0xa4c68000U, 0x00038d7eU, 0x00000000U},  // 10^15
+    {0x6fc10000U, 0x002386f2U, 0x00000000U},  // 10^16
+    {0x5d8a0000U, 0x01634578U, 0x00000000U},  // 10^17
+    {0xa7640000U, 0x0de0b6b3U, 0x00000000U},  // 10^18
+    {0x89e80000U, 0x8ac72304U, 0x00000000U},  // 10^19
+    {0x63100000U, 0x6bc75e2dU, 0x00000005U},  // 10^20
+    {0xdea00000U, 0x35c9adc5U, 0x00000036U},  // 10^21
+    {0xb2400000U, 0x19e0c9baU, 0x0000021eU},  // 10^22
+    {0xf6800000U, 0x02c7e14aU, 0x0000152dU},  // 10^23
+    {0xa1000000U, 0x1bceccedU, 0x0000d3c2U},  // 10^24
+    {0x4a000000U, 0x16140148U, 0x00084595U},  // 10^25
+    {0xe4000000U, 0xdcc80cd2U, 0x0052b7d2U},  // 10^26
+    {0xe8000000U, 0x9fd0803cU, 0x033b2e3cU},  // 10^27
+    {0x10000000U, 0x3e250261U, 0x204fce5eU},  // 10^28
+};
 
 /**
  * @brief Получение значения бита
@@ -125,257 +198,903 @@ int s21_test_zero(s21_decimal *val) {
 }
 
 /**
- * @brief Сложение двух чисел Decimal
+ * @brief Перевод мантиссы числа Decimal в длинное число
  *
- * @param value_1 первое слагаемое
- * @param value_2 второе слагаемое
- * @param result результат сложения
+ * @param value число децимал
+ * @param big указатель на длинное число для записи мантиссы
  * @param Владимир
- * @return int возвращают код ошибки
  */
-int s21_add(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
-  int ret = OK;
-  s21_decimal temp_res;
-  temp_res.bits[0] = temp_res.bits[1] = temp_res.bits[2] = temp_res.bits[3] = 0;
-  int sign1 = s21_bit(value_1, 127);
-  int sign2 = s21_bit(value_2, 127);
-  if (sign1 && sign2) {
-    s21_toggle_bit(&temp_res, 127);
+void s21_to_big(const s21_decimal value, s21_big_decimal *big) {
+  *big = (s21_big_decimal){{0}};
+  for (int i = 0; i < 3; i++) big->bits[i] = (uint32_t)value.bits[i];
+}
+
+/**
+ * @brief Проверка, помещается ли длинное число в 96 бит мантиссы Decimal
+ *
+ * @param big указатель на длинное число
+ * @param Владимир
+ * @return int 1 - помещается, 0 - нет
+ */
+int s21_big_fits(const s21_big_decimal *big) {
+  int rez = 1;
+  for (int i = 3; i < BIG_LIMBS && rez; i++)
+    if (big->bits[i]) rez = 0;
+  return rez;
+}
+
+/**
+ * @brief Проверка длинного числа на ноль
+ *
+ * @param big указатель на длинное число
+ * @param Владимир
+ * @return int 1 - число равно 0, 0 - число не равно нулю
+ */
+int s21_big_is_zero(const s21_big_decimal *big) {
+  int rez = 1;
+  for (int i = 0; i < BIG_LIMBS && rez; i++)
+    if (big->bits[i]) rez = 0;
+  return rez;
+}
+
+/**
+ * @brief Подсчет количества значащих битов длинного числа
+ *
+ * @param big указатель на длинное число
+ * @param Владимир
+ * @return int номер старшего единичного бита плюс один, 0 для нуля
+ */
+int s21_big_bits(const s21_big_decimal *big) {
+  int end = 0, i = BIG_LIMBS - 1;
+  while (i >= 0 && !big->bits[i]) i--;
+  if (i >= 0) {
+    end = i * 32;
+    for (uint32_t word = big->bits[i]; word; word >>= 1) end++;
+  }
+  return end;
+}
+
+/**
+ * @brief Сравнение двух длинных чисел
+ *
+ * @param big_1 первое число
+ * @param big_2 второе число
+ * @param Владимир
+ * @return int -1 - первое меньше, 0 - равны, 1 - первое больше
+ */
+int s21_big_cmp(const s21_big_decimal *big_1, const s21_big_decimal *big_2) {
+  int rez = 0;
+  for (int i = BIG_LIMBS - 1; i >= 0 && !rez; i--)
+    if (big_1->bits[i] != big_2->bits[i])
+      rez = big_1->bits[i] > big_2->bits[i] ? 1 : -1;
+  return rez;
+}
+
+/**
+ * @brief Сложение двух длинных чисел с переносом между словами
+ *
+ * @param big_1 первое слагаемое
+ * @param big_2 второе слагаемое
+ * @param rez результат сложения
+ * @param Владимир
+ */
+void s21_big_add(const s21_big_decimal *big_1, const s21_big_decimal *big_2,
+                 s21_big_decimal *rez) {
+  uint64_t carry = 0;
+  for (int i = 0; i < BIG_LIMBS; i++) {
+    carry += (uint64_t)big_1->bits[i] + big_2->bits[i];
+    rez->bits[i] = (uint32_t)carry;
+    carry >>= 32;
+  }
+}
+
+/**
+ * @brief Вычитание длинных чисел, уменьшаемое должно быть не меньше
+ * вычитаемого
+ *
+ * @param big_1 уменьшаемое
+ * @param big_2 вычитаемое
+ * @param rez результат вычитания
+ * @param Владимир
+ */
+void s21_big_sub(const s21_big_decimal *big_1, const s21_big_decimal *big_2,
+                 s21_big_decimal *rez) {
+  uint64_t borrow = 0;
+  for (int i = 0; i < BIG_LIMBS; i++) {
+    uint64_t temp = (uint64_t)big_1->bits[i] - big_2->bits[i] - borrow;
+    rez->bits[i] = (uint32_t)temp;
+    borrow = (temp >> 32) & 1u;
+  }
+}
+
+/**
+ * @brief Умножение длинного числа на 32-битное слово
+ *
+ * @param big указатель на длинное число
+ * @param num множитель
+ * @param Владимир
+ * @return uint32_t перенос, не поместившийся в старшее слово
+ */
+uint32_t s21_big_mul_word(s21_big_decimal *big, const uint32_t num) {
+  uint64_t carry = 0;
+  for (int i = 0; i < BIG_LIMBS; i++) {
+    carry += (uint64_t)big->bits[i] * num;
+    big->bits[i] = (uint32_t)carry;
+    carry >>= 32;
+  }
+  return (uint32_t)carry;
+}
+
+/**
+ * @brief Деление длинного числа на 32-битное слово
+ *
+ * @param big указатель на длинное число, в него записывается частное
+ * @param num делитель
+ * @param Владимир
+ * @return uint32_t остаток от деления
+ */
+uint32_t s21_big_div_word(s21_big_decimal *big, const uint32_t num) {
+  uint64_t rem = 0;
+  for (int i = BIG_LIMBS - 1; i >= 0; i--) {
+    rem = (rem << 32) | big->bits[i];
+    big->bits[i] = (uint32_t)(rem / num);
+    rem %= num;
+  }
+  return (uint32_t)rem;
+}
+
+/**
+ * @brief Деление длинного числа на 10 в степени num от 1 до 9 без аппаратного
+ * деления: каждое слово частного получается умножением на обратное значение
+ * нормализованного делителя с одной-двумя поправками (Мёллер, Гранлунд)
+ *
+ * @param big указатель на длинное число, в него записывается частное
+ * @param num показатель степени от 1 до 9
+ * @param Владимир
+ * @return uint32_t остаток от деления
+ */
+uint32_t s21_big_div_pow10(s21_big_decimal *big, const int num) {
+  const uint32_t shift = pow10_recip[num][0], d = pow10_recip[num][1],
+                 inv = pow10_recip[num][2];
+  int top = BIG_LIMBS - 1;
+  while (top > 0 && !big->bits[top]) top--;
+  uint32_t rem = (uint32_t)((uint64_t)big->bits[top] >> (32 - shift));
+  for (int i = top; i >= 0; i--) {
+    uint32_t low =
+        i ? (uint32_t)((uint64_t)big->bits[i - 1] >> (32 - shift)) : 0;
+    uint32_t word = (big->bits[i] << shift) | low;
+    uint64_t temp = (uint64_t)inv * rem + (((uint64_t)rem << 32) | word);
+    uint32_t q = (uint32_t)(temp >> 32) + 1, r = word - q * d;
+    if (r > (uint32_t)temp) q--, r += d;
+    if (r >= d) q++, r -= d;
+    big->bits[i] = q, rem = r;
+  }
+  return rem >> shift;
+}
+
+/**
+ * @brief Умножение мантисс двух чисел Decimal: полное 192-битное произведение
+ * столбиком по 32-битным словам
+ *
+ * @param value_1 первый множитель
+ * @param value_2 второй множитель
+ * @param rez длинное число для записи произведения
+ * @param Владимир
+ */
+void s21_mul_words(const s21_decimal value_1, const s21_decimal value_2,
+                   s21_big_decimal *rez) {
+  *rez = (s21_big_decimal){{0}};
+#ifdef __SIZEOF_INT128__
+  // мантисса как 64-битная младшая часть и 32-битная старшая
+  uint64_t lo_1 = (uint32_t)value_1.bits[0] |
+                  (uint64_t)(uint32_t)value_1.bits[1] << 32,
+           lo_2 = (uint32_t)value_2.bits[0] |
+                  (uint64_t)(uint32_t)value_2.bits[1] << 32;
+  uint64_t hi_1 = (uint32_t)value_1.bits[2], hi_2 = (uint32_t)value_2.bits[2];
+  unsigned __int128 low = (unsigned __int128)lo_1 * lo_2;
+  unsigned __int128 mid =
+      (unsigned __int128)lo_1 * hi_2 + (unsigned __int128)lo_2 * hi_1;
+  unsigned __int128 high = (unsigned __int128)hi_1 * hi_2;
+  mid += (uint64_t)(low >> 64);
+  high += mid >> 64;
+  rez->bits[0] = (uint32_t)low;
+  rez->bits[1] = (uint32_t)(low >> 32);
+  rez->bits[2] = (uint32_t)mid;
+  rez->bits[3] = (uint32_t)(mid >> 32);
+  rez->bits[4] = (uint32_t)high;
+  rez->bits[5] = (uint32_t)(high >> 32);
+#else
+  for (int i = 0; i < 3; i++) {
+    uint64_t carry = 0;
+    for (int j = 0; j < 3; j++) {
+      carry += (uint64_t)(uint32_t)value_1.bits[i] * (uint32_t)value_2.bits[j] +
+               rez->bits[i + j];
+      rez->bits[i + j] = (uint32_t)carry;
+      carry >>= 32;
+    }
+    rez->bits[i + 3] = (uint32_t)carry;
+  }
+#endif
+}
+
+/**
+ * @brief Деление длинных чисел столбиком по 32-битным словам (алгоритм D
+ * Кнута): делитель нормализуется сдвигом, цифра частного оценивается по двум
+ * старшим словам и уточняется не более чем двумя поправками
+ *
+ * @param big_1 делимое
+ * @param big_2 делитель, не равный нулю
+ * @param quot частное
+ * @param rem остаток от деления
+ * @param Владимир
+ */
+void s21_big_divmod(const s21_big_decimal *big_1, const s21_big_decimal *big_2,
+                    s21_big_decimal *quot, s21_big_decimal *rem) {
+  int m = BIG_LIMBS, n = BIG_LIMBS;
+  while (m > 0 && !big_1->bits[m - 1]) m--;
+  while (n > 0 && !big_2->bits[n - 1]) n--;
+  s21_big_decimal q = {{0}}, r = {{0}};
+  if (m < n) {
+    r = *big_1;
+  } else if (n == 1) {
+    q = *big_1;
+    r.bits[0] = s21_big_div_word(&q, big_2->bits[0]);
   } else {
-    if (sign1 > sign2) {
-      s21_toggle_bit(&value_1, 127);
-      ret = s21_sub(value_2, value_1, &temp_res);
-    } else {
-      if (sign1 < sign2) {
-        s21_toggle_bit(&value_2, 127);
-        ret = s21_sub(value_1, value_2, &temp_res);
+    const uint32_t *u = big_1->bits, *v = big_2->bits;
+    uint32_t un[BIG_LIMBS + 1], vn[BIG_LIMBS];
+    int shift = 0;
+    while (!((v[n - 1] << shift) >> 31)) shift++;
+    for (int i = n - 1; i > 0; i--)
+      vn[i] = (v[i] << shift) | (uint32_t)((uint64_t)v[i - 1] >> (32 - shift));
+    vn[0] = v[0] << shift;
+    un[m] = (uint32_t)((uint64_t)u[m - 1] >> (32 - shift));
+    for (int i = m - 1; i > 0; i--)
+      un[i] = (u[i] << shift) | (uint32_t)((uint64_t)u[i - 1] >> (32 - shift));
+    un[0] = u[0] << shift;
+    for (int j = m - n; j >= 0; j--) {
+      uint64_t num = ((uint64_t)un[j + n] << 32) | un[j + n - 1];
+      uint64_t qhat = num / vn[n - 1], rhat = num % vn[n - 1];
+      while (qhat >> 32 ||
+             qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+        qhat--, rhat += vn[n - 1];
+        if (rhat >> 32) break;
+      }
+      int64_t temp = 0;
+      uint64_t borrow = 0;
+      for (int i = 0; i < n; i++) {
+        uint64_t p = qhat * vn[i];
+        temp = (int64_t)un[i + j] - (int64_t)borrow - (int64_t)(p & MAXBITS);
+        un[i + j] = (uint32_t)temp;
+        borrow = (p >> 32) - (temp >> 32);
+      }
+      temp = (int64_t)un[j + n] - (int64_t)borrow;
+      un[j + n] = (uint32_t)temp;
+      q.bits[j] = (uint32_t)qhat;
+      if (temp < 0) {
+        // оценка оказалась на единицу больше, прибавляем делитель обратно
+        uint64_t carry = 0;
+        q.bits[j]--;
+        for (int i = 0; i < n; i++) {
+          carry += (uint64_t)un[i + j] + vn[i];
+          un[i + j] = (uint32_t)carry;
+          carry >>= 32;
+        }
+        un[j + n] += (uint32_t)carry;
       }
     }
+    for (int i = 0; i < n - 1; i++)
+      r.bits[i] = (un[i] >> shift) | (uint32_t)((uint64_t)un[i + 1] << 32 >>
+                                                shift);
+    r.bits[n - 1] = un[n - 1] >> shift;
   }
-  if (sign1 == sign2 && !ret) {
-    char val_1[MAXSTR], val_2[MAXSTR], rez[MAXSTR];
-    s21_init(val_1), s21_init(val_2), s21_init(rez);
-    s21_str_scale(&value_1, &value_2, val_1, val_2);
-    s21_add_str(val_1, val_2, rez);
-    int max_scale = s21_scale(value_1);
-    ret = s21_buh_round(rez, &max_scale, 0);
-    if (!ret) {
-      temp_res.bits[3] ^= (max_scale << 16);
-      s21_div_decimal_to_two(&temp_res, rez);
-      s21_test_zero(&temp_res);
+  *quot = q, *rem = r;
+}
+
+/**
+ * @brief Умножение двух длинных чисел столбиком, старшие слова сверх
+ * BIG_LIMBS отбрасываются
+ *
+ * @param big_1 первый множитель
+ * @param big_2 второй множитель
+ * @param rez результат умножения, может совпадать с множителем
+ * @param Владимир
+ */
+void s21_big_mul(const s21_big_decimal *big_1, const s21_big_decimal *big_2,
+                 s21_big_decimal *rez) {
+  s21_big_decimal temp = {{0}};
+  int len = BIG_LIMBS;
+  while (len > 0 && !big_2->bits[len - 1]) len--;
+  for (int i = 0; i < BIG_LIMBS; i++) {
+    if (!big_1->bits[i]) continue;
+    uint64_t carry = 0;
+    int j = 0;
+    for (; j < len && i + j < BIG_LIMBS; j++) {
+      carry += (uint64_t)big_1->bits[i] * big_2->bits[j] + temp.bits[i + j];
+      temp.bits[i + j] = (uint32_t)carry;
+      carry >>= 32;
     }
-    if (ret == 1) ret = (s21_bit(value_1, 127)) ? NEGATIVE_INF : INF;
+    // предыдущие строки не заходят дальше слова i + len - 1
+    if (i + j < BIG_LIMBS) temp.bits[i + j] = (uint32_t)carry;
   }
-  *result = temp_res;
-  return ret;
+  *rez = temp;
 }
 
 /**
- * @brief Вычитание чисел Decimal
+ * @brief Загрузка 10 в степени num из таблицы в длинное число
  *
- * @param value_1 первое число
- * @param value_2 второе число
- * @param result результат вычитания
+ * @param num показатель степени от 0 до 28
+ * @param big указатель на длинное число
  * @param Владимир
- * @return int возвращают код ошибки
  */
-int s21_sub(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
-  int ret = OK;
-  s21_decimal temp_res;
-  temp_res.bits[0] = temp_res.bits[1] = temp_res.bits[2] = temp_res.bits[3] = 0;
-  int sign1 = s21_bit(value_1, 127);
-  int sign2 = s21_bit(value_2, 127);
-  if (sign1 != sign2) {
-    if (sign1)
-      s21_toggle_bit(&value_1, 127);
-    else
-      s21_toggle_bit(&value_2, 127);
-    ret = s21_add(value_1, value_2, &temp_res);
-    if (sign1) s21_toggle_bit(&temp_res, 127);
-  } else {
-    char val_1[MAXSTR], val_2[MAXSTR];
-    s21_init(val_1), s21_init(val_2);
-    s21_str_scale(&value_1, &value_2, val_1, val_2);
-    char rez[MAXSTR];
-    s21_init(rez);
-    if (strcmp(val_1, val_2) >= 0) {
-      if (sign1) s21_toggle_bit(&temp_res, 127);
-      s21_sub_str(val_1, val_2, rez);
+void s21_big_pow10(const int num, s21_big_decimal *big) {
+  *big = (s21_big_decimal){{0}};
+  for (int i = 0; i < 3; i++) big->bits[i] = pow10_bits[num][i];
+}
 
+/**
+ * @brief Умножение длинного числа на 10 в степени num одним умножением на
+ * значение из таблицы
+ *
+ * @param big указатель на длинное число
+ * @param num показатель степени
+ * @param Владимир
+ */
+void s21_big_scale_up(s21_big_decimal *big, int num) {
+  for (; num > 0; num -= MAXEXP) {
+    int part = num > MAXEXP ? MAXEXP : num;
+    if (part <= 9) {
+      s21_big_mul_word(big, pow10_bits[part][0]);
     } else {
-      if (!sign1) s21_toggle_bit(&temp_res, 127);
-      s21_sub_str(val_2, val_1, rez);
+      s21_big_decimal pow;
+      s21_big_pow10(part, &pow);
+      s21_big_mul(big, &pow, big);
     }
-    int max_scale = s21_scale(value_1);
-    ret = s21_buh_round(rez, &max_scale, 0);
-    if (!ret) {
-      temp_res.bits[3] ^= (max_scale << 16);
-      s21_div_decimal_to_two(&temp_res, rez);
-      s21_test_zero(&temp_res);
+  }
+}
+
+/**
+ * @brief Деление модуля длинного числа на 10 в степени num умножением на
+ * обратные значения, по 9 цифр за шаг, с округлением по остатку. Младшие
+ * шаги дают только признак ненулевого остатка, решение об округлении
+ * принимается по остатку старшего шага против половины делителя
+ *
+ * @param big указатель на длинное число, в него записывается результат
+ * @param num показатель степени, больше нуля
+ * @param flag способ округления модуля: ROUND_BANK, ROUND_TRUNC,
+ * ROUND_HALF_UP, ROUND_FLOOR - к нулю, ROUND_CEIL - от нуля
+ * @param Владимир
+ */
+void s21_big_scale_down(s21_big_decimal *big, int num, int flag) {
+  int sticky = 0;
+  for (; num > 9; num -= 9)
+    if (s21_big_div_pow10(big, 9)) sticky = 1;
+  uint32_t rem = s21_big_div_pow10(big, num);
+  if (rem || sticky) {
+    uint64_t twice = (uint64_t)rem * 2;
+    int half = twice == pow10_u64[num] ? 0 : twice > pow10_u64[num] ? 1 : -1;
+    if (half == 0 && sticky) half = 1;
+    int up = 0;
+    if (flag == ROUND_BANK)
+      up = half > 0 || (half == 0 && (big->bits[0] & 1u));
+    else if (flag == ROUND_HALF_UP)
+      up = half >= 0;
+    else if (flag == ROUND_CEIL)
+      up = 1;
+    if (up) {
+      s21_big_decimal one = {{1}};
+      s21_big_add(big, &one, big);
     }
   }
-  if (ret == 1)
-    ret = (s21_bit(temp_res, 127)) ? NEGATIVE_INF : INF;
-  else
-    s21_test_zero(&temp_res);
+}
 
-  *result = temp_res;
+/**
+ * @brief Побитовый сдвиг длинного числа влево, старшие биты за пределами
+ * BIG_LIMBS теряются
+ *
+ * @param big указатель на длинное число
+ * @param num количество сдвигаемых битов
+ * @param Владимир
+ */
+void s21_big_shift_left(s21_big_decimal *big, int num) {
+  int words = num / 32, rest = num % 32;
+  for (int i = BIG_LIMBS - 1; i >= 0; i--) {
+    uint32_t word = i >= words ? big->bits[i - words] << rest : 0;
+    if (rest && i > words) word |= big->bits[i - words - 1] >> (32 - rest);
+    big->bits[i] = word;
+  }
+}
 
-  return ret;
+/**
+ * @brief Побитовый сдвиг модуля длинного числа вправо с округлением по
+ * выпавшим битам
+ *
+ * @param big указатель на длинное число
+ * @param num количество сдвигаемых битов
+ * @param flag способ округления модуля, как в s21_big_scale_down
+ * @param Владимир
+ */
+void s21_big_shift_right(s21_big_decimal *big, int num, int flag) {
+  int half = -1, sticky = 0;
+  if (num > 0 && num <= 32 * BIG_LIMBS) {
+    int top = num - 1;
+    half = (big->bits[top / 32] >> (top % 32)) & 1u ? 0 : -1;
+    for (int i = 0; i < top / 32 && !sticky; i++) sticky = big->bits[i] != 0;
+    if (top % 32 && (big->bits[top / 32] & ((1u << (top % 32)) - 1)))
+      sticky = 1;
+  } else if (num > 0) {
+    sticky = !s21_big_is_zero(big);
+  }
+  if (half == 0 && sticky) half = 1, sticky = 0;
+  int words = num / 32, rest = num % 32;
+  for (int i = 0; i < BIG_LIMBS; i++) {
+    uint32_t word = i + words < BIG_LIMBS ? big->bits[i + words] >> rest : 0;
+    if (rest && i + words + 1 < BIG_LIMBS)
+      word |= big->bits[i + words + 1] << (32 - rest);
+    big->bits[i] = word;
+  }
+  int up = 0;
+  if (half >= 0 || sticky) {
+    if (flag == ROUND_BANK)
+      up = half > 0 || (half == 0 && (big->bits[0] & 1u));
+    else if (flag == ROUND_HALF_UP)
+      up = half >= 0;
+    else if (flag == ROUND_CEIL)
+      up = 1;
+  }
+  if (up) {
+    s21_big_decimal one = {{1}};
+    s21_big_add(big, &one, big);
+  }
 }
 
 /**
- * @brief Функция преобразует Decimal в десятичный вид в строку и выравнивает
- * показатели степени
+ * @brief Округление длинного числа до мантиссы Decimal без удаления нулей:
+ * отбрасывается наименьшее количество цифр, при котором степень не больше
+ * 28, а мантисса не больше 96 бит
  *
- * @param value_1 первое число decimal
- * @param value_2 второе число decimal
- * @param val_1 первое число преобразованное в строку
- * @param val_2 второе число преобразованное в строку
+ * @param big указатель на длинное число
+ * @param scale указатель на показатель степени
+ * @param flag способ округления, как в s21_big_scale_down
  * @param Владимир
+ * @return int возвращает ОК или INF при числе выходящим за границы Decimal
  */
-void s21_str_scale(s21_decimal *value_1, s21_decimal *value_2, char *val_1,
-                   char *val_2) {
-  s21_mul_two_to_decimal(*value_1, val_1);
-  s21_mul_two_to_decimal(*value_2, val_2);
-  int scale1 = s21_scale(*value_1), scale2 = s21_scale(*value_2);
-  int scale = scale1 - scale2;
-  if (scale > 0) {
-    s21_shift_scale_str(val_2, scale);
-    value_2->bits[3] |= (s21_scale(*value_1) << 16);
+int s21_big_fit(s21_big_decimal *big, int *scale, int flag) {
+  int rez = OK, num = *scale > MAXEXP ? *scale - MAXEXP : 0;
+  if (!s21_big_fits(big)) {
+    // 77/256 чуть меньше log10(2), оценка снизу для количества лишних цифр
+    int est = ((s21_big_bits(big) - 96) * 77) >> 8;
+    if (est > num) num = est;
   }
-  if (scale < 0) {
-    s21_shift_scale_str(val_1, -scale);
-    value_1->bits[3] |= (s21_scale(*value_2) << 16);
+  s21_big_decimal temp = *big;
+  if (num > 0 && num <= *scale) s21_big_scale_down(&temp, num, flag);
+  while (!s21_big_fits(&temp) && num < *scale) {
+    temp = *big;
+    s21_big_scale_down(&temp, ++num, flag);
   }
+  if (num > *scale || !s21_big_fits(&temp))
+    rez = INF;
+  else
+    *big = temp, *scale -= num;
+  return rez;
 }
 
 /**
- * @brief Функция преобразования из типа float в тип Decimal
+ * @brief Округление длинного числа до мантиссы Decimal: степень не больше 28,
+ * мантисса не больше 96 бит, не значащие нули после запятой удаляются
  *
- * @param src исходное число float
- * @param dst указатель на число decimal, в которое сохраняем результат
+ * @param big указатель на длинное число
+ * @param scale указатель на показатель степени
+ * @param flag ROUND_BANK - бухгалтерское округление, ROUND_TRUNC -
+ * отбрасывание лишних цифр
  * @param Владимир
- * @return int 0 - OK, 1 - ошибка конвертации
+ * @return int возвращает ОК или INF при числе выходящим за границы Decimal
  */
-int s21_from_float_to_decimal(float src, s21_decimal *dst) {
-  int rezult = OK;
-  dst->bits[0] = dst->bits[1] = dst->bits[2] = dst->bits[3] = 0;
-  if (fabs(src) < FLOAT_MIN || isnan(src) || isinf(src)) {
-    rezult = ERROR;
-  } else {
-    uint32_t fl;
-    memcpy(&fl, &src, sizeof(uint32_t));
-    if ((fl >> 31) & 1u) s21_toggle_bit(dst, 127);
-    int exp = (int)((unsigned char)(fl >> 23)) - 127;
-    float mantisa = 1.0;
-    if (exp == -127) mantisa = 0.0, exp += 127;
-    for (int i = 22; i >= 0; i--)
-      if ((fl >> i) & 1u) mantisa += pow(2, -(23 - i));
-    mantisa *= pow(2, exp);
-    char buffer[MAXSTR];
-    s21_init(buffer);
-    snprintf(buffer, MAXSTR, "%.29f", mantisa);
-    int val = strlen(buffer) - 1;
-    char *ach;
-    ach = strchr(buffer, '.');
-    if (ach != NULL) {  // считаем коэффициент масштабирования
-      int buflen = 0;
-      buflen = ach - buffer + 1;
-      for (unsigned int j = buflen - 1; j < strlen(buffer); j++)
-        buffer[j] = buffer[j + 1];
-      buflen = strlen(buffer) - buflen + 1;
-      buffer[val--] = '\0';
-      rezult = s21_buh_round(buffer, &buflen, 1);
-      if (buflen) dst->bits[3] ^= (buflen << 16);
-    }
-    s21_div_decimal_to_two(dst, buffer);
+int s21_big_round(s21_big_decimal *big, int *scale, int flag) {
+  int rez = s21_big_fit(big, scale, flag);
+  while (rez == OK && *scale > 0 && !s21_big_is_zero(big)) {
+    s21_big_decimal temp = *big;
+    if (s21_big_div_pow10(&temp, 1)) break;
+    *big = temp, (*scale)--;
   }
-  return rezult;
+  return rez;
 }
 
 /**
- * @brief Функция удаляет не значащие нули в начале строки и после запятой,
- * уменьшая степень
+ * @brief Запись длинного числа в Decimal, ноль записывается без знака и
+ * степени
  *
- * @param buffer строка с числом в десятичном виде
- * @param buflen показатель степени
+ * @param big указатель на длинное число, помещающееся в 96 бит
+ * @param scale показатель степени
+ * @param sign знак: 0 - плюс, 1 - минус
+ * @param dst указатель на число децимал
  * @param Владимир
  */
-void s21_buh_round_zero(char *buffer, int *buflen) {
-  int val_str = strlen(buffer) - 1;
-  while ((*buflen) > 0 && val_str > 0 && buffer[val_str] == '0')
-    val_str--, (*buflen)--;
-  buffer[val_str + 1] = '\0';
-  int i = 0;
-  while (buffer[i] == '0' && buffer[i + 1] != '\0') i++;
-  for (unsigned int j = 0; j < strlen(buffer) - i; j++)
-    buffer[j] = buffer[j + i];
-  buffer[strlen(buffer) - i] = '\0';
+void s21_from_big(const s21_big_decimal *big, int scale, int sign,
+                  s21_decimal *dst) {
+  for (int i = 0; i < 3; i++) dst->bits[i] = (int)big->bits[i];
+  dst->bits[3] = (scale << 16) | (sign ? MINUS : PLUS);
+  s21_test_zero(dst);
 }
 
 /**
- * @brief Функция округляет пока нужно девятку изменить на ноль
+ * @brief Сложение чисел Decimal в двоичном виде: выравнивание степеней
+ * умножением на 10^n в длинном числе, сложение или вычитание мантисс с
+ * переносом и бухгалтерское округление
  *
- * @param buffer строка с числом в десятичном виде
- * @param buflen показатель степени
- * @param val номер символа в строке, по который нужно обрезать
+ * @param value_1 первое слагаемое
+ * @param value_2 второе слагаемое
+ * @param sign2 знак второго слагаемого: 0 - плюс, 1 - минус
+ * @param result результат сложения
  * @param Владимир
+ * @return int возвращают код ошибки
  */
-int s21_buh_round_nine(char *buffer, int *buflen, int val) {
-  buffer[val] = '\0';
-  val--;
-  int res = 0;
-  while (buffer[val] == '9' && val > 0) buffer[val--] = '0';
-  if (val == 0 && buffer[val] == '9') {
-    buffer[0] = '0';
-    for (int j = strlen(buffer); j >= 0; j--) buffer[j + 1] = buffer[j];
-    buffer[0] = '1';
-    res = s21_buh_round(buffer, buflen, 0);
+int s21_add_big(s21_decimal value_1, s21_decimal value_2, int sign2,
+                s21_decimal *result) {
+  atomic_fetch_add_explicit(&fast_misses, 1, memory_order_relaxed);
+  int scale1 = s21_scale(value_1), scale2 = s21_scale(value_2);
+  s21_big_decimal big_1, big_2;
+  s21_to_big(value_1, &big_1);
+  s21_to_big(value_2, &big_2);
+  return s21_big_sum(&big_1, scale1, s21_bit(value_1, 127), &big_2, scale2,
+                     sign2, result);
+}
+
+/**
+ * @brief Сумма двух длинных чисел со знаками и степенями: выравнивание
+ * степеней, сложение или вычитание модулей и одно бухгалтерское округление
+ * результата до Decimal
+ *
+ * @param big_1 указатель на модуль первого слагаемого, изменяется
+ * @param scale1 степень первого слагаемого
+ * @param sign1 знак первого слагаемого: 0 - плюс, 1 - минус
+ * @param big_2 указатель на модуль второго слагаемого, изменяется
+ * @param scale2 степень второго слагаемого
+ * @param sign2 знак второго слагаемого: 0 - плюс, 1 - минус
+ * @param result результат сложения
+ * @param Владимир
+ * @return int возвращают код ошибки
+ */
+int s21_big_sum(s21_big_decimal *big_1, int scale1, int sign1,
+                s21_big_decimal *big_2, int scale2, int sign2,
+                s21_decimal *result) {
+  int sign = sign1, scale = scale1 > scale2 ? scale1 : scale2;
+  s21_big_decimal rez;
+  s21_big_scale_up(big_1, scale - scale1);
+  s21_big_scale_up(big_2, scale - scale2);
+  if (sign == sign2) {
+    s21_big_add(big_1, big_2, &rez);
+  } else if (s21_big_cmp(big_1, big_2) >= 0) {
+    s21_big_sub(big_1, big_2, &rez);
   } else {
-    buffer[val]++;
+    s21_big_sub(big_2, big_1, &rez);
+    sign = sign2;
   }
-  return res;
+  int ret = s21_big_round(&rez, &scale, ROUND_BANK);
+  *result = dec_null;
+  if (ret == OK)
+    s21_from_big(&rez, scale, sign, result);
+  else if (sign)
+    ret = NEGATIVE_INF, result->bits[3] = MINUS;
+  return ret;
 }
 
 /**
- * @brief Функция бухгалтерского округления, попутно удаляет не значащие нули в
- * начале строки и после запятой, уменьшая степень
+ * @brief Запись 64-битной мантиссы в Decimal с удалением не значащих нулей
+ * после запятой, ноль записывается без знака и степени
  *
- * @param buffer строка с числом в десятичном виде
- * @param buflen показатель степени
- * @param flag 0-бухгалтерское огругление; 1-округление до 7 значащих цифр;
- * 2-простое округление
+ * @param val мантисса
+ * @param scale показатель степени, не больше 28
+ * @param sign знак: 0 - плюс, 1 - минус
+ * @param dst указатель на число децимал
  * @param Владимир
- * @return int возвращает ОК или INF при числе выходящим за границы Decimal
  */
-int s21_buh_round(char *buffer, int *buflen, int flag) {
-  int rez = OK;
-  s21_buh_round_zero(buffer, buflen);
-  int val = strlen(buffer);
-  if (val - *buflen <= MAXDEC && *buflen - val <= MAXEXP) {
-    if (*buflen > 28) val -= *buflen - MAXEXP, *buflen = MAXEXP;
-    if (val > 29) *buflen -= (val - MAXDEC), val = MAXDEC;
-    if (val > 0 && *buflen >= 0) {
-      if (flag == 1 && val > FLOAT_ROUND) {
-        for (int j = FLOAT_ROUND + 1; j < (int)strlen(buffer); j++)
-          buffer[j] = '0';
-        flag = 0;
-        *buflen =
-            (*buflen - val + FLOAT_ROUND > 0) ? *buflen - val + FLOAT_ROUND : 0;
-        val = FLOAT_ROUND;
-        // flag=2; если все таки нужно простое округление на флоате
-      }
-      if (buffer[val] > '5' ||
-          (buffer[val] == '5' &&
-           ((buffer[val - 1] % 2 == 1 && flag == 0) || flag == 2))) {
-        if (buffer[val - 1] == '9')
-          rez = s21_buh_round_nine(buffer, buflen, val);
-        else
-          buffer[val - 1]++, buffer[val] = '0';
-      }
-      if (*buflen > 0 || val == 29) buffer[val] = '\0';
-      s21_buh_round_zero(buffer, buflen);
+void s21_from_u64(uint64_t val, int scale, int sign, s21_decimal *dst) {
+  while (scale > 0 && val % 10 == 0) val /= 10, scale--;
+  dst->bits[0] = (int)(uint32_t)val;
+  dst->bits[1] = (int)(uint32_t)(val >> 32);
+  dst->bits[2] = 0;
+  dst->bits[3] = val ? (scale << 16) | (sign ? MINUS : PLUS) : 0;
+}
+
+/**
+ * @brief Быстрое сложение для мантисс до 64 бит: выравнивание степеней и
+ * сумма без переполнения 64-битного слова не требуют округления
+ *
+ * @param value_1 первое слагаемое
+ * @param value_2 второе слагаемое
+ * @param sign2 знак второго слагаемого: 0 - плюс, 1 - минус
+ * @param result результат сложения
+ * @param Владимир
+ * @return int TRUE - результат записан, FALSE - нужен общий путь
+ */
+int s21_add_u64(s21_decimal value_1, s21_decimal value_2, int sign2,
+                s21_decimal *result) {
+  int done = FALSE;
+  int scale1 = s21_scale(value_1), scale2 = s21_scale(value_2);
+  if (!value_1.bits[2] && !value_2.bits[2] && scale1 <= MAXEXP &&
+      scale2 <= MAXEXP) {
+    uint64_t val_1 = (uint32_t)value_1.bits[0] |
+                     (uint64_t)(uint32_t)value_1.bits[1] << 32;
+    uint64_t val_2 = (uint32_t)value_2.bits[0] |
+                     (uint64_t)(uint32_t)value_2.bits[1] << 32;
+    int sign = s21_bit(value_1, 127);
+    int scale = scale1 > scale2 ? scale1 : scale2;
+    int up_1 = scale - scale1, up_2 = scale - scale2;
+    int fits = up_1 < 20 && up_2 < 20 &&
+               !__builtin_mul_overflow(val_1, pow10_u64[up_1], &val_1) &&
+               !__builtin_mul_overflow(val_2, pow10_u64[up_2], &val_2);
+    if (fits && sign == sign2) {
+      fits = !__builtin_add_overflow(val_1, val_2, &val_1);
+    } else if (fits) {
+      if (val_1 < val_2)
+        val_1 = val_2 - val_1, sign = sign2;
+      else
+        val_1 -= val_2;
+    }
+    if (fits) {
+      s21_from_u64(val_1, scale, sign, result);
+      atomic_fetch_add_explicit(&fast_hits, 1, memory_order_relaxed);
+      done = TRUE;
+    }
+  }
+  return done;
+}
+
+/**
+ * @brief Быстрое умножение для мантисс до 64 бит: произведение в одном
+ * 64-битном слове при степени не больше 28 не требует округления
+ *
+ * @param value_1 первый множитель
+ * @param value_2 второй множитель
+ * @param result результат умножения
+ * @param Владимир
+ * @return int TRUE - результат записан, FALSE - нужен общий путь
+ */
+int s21_mul_u64(s21_decimal value_1, s21_decimal value_2,
+                s21_decimal *result) {
+  int done = FALSE;
+  int scale = s21_scale(value_1) + s21_scale(value_2);
+  uint64_t val_1 = (uint32_t)value_1.bits[0] |
+                   (uint64_t)(uint32_t)value_1.bits[1] << 32;
+  uint64_t val_2 = (uint32_t)value_2.bits[0] |
+                   (uint64_t)(uint32_t)value_2.bits[1] << 32;
+  if (!value_1.bits[2] && !value_2.bits[2] && scale <= MAXEXP &&
+      !__builtin_mul_overflow(val_1, val_2, &val_1)) {
+    s21_from_u64(val_1, scale,
+                 s21_bit(value_1, 127) ^ s21_bit(value_2, 127), result);
+    atomic_fetch_add_explicit(&fast_hits, 1, memory_order_relaxed);
+    done = TRUE;
+  }
+  return done;
+}
+
+/**
+ * @brief Значения счетчиков быстрого пути
+ *
+ * @param stats указатель на структуру для записи счетчиков
+ * @param Владимир
+ */
+void s21_get_fast_stats(s21_fast_stats *stats) {
+  stats->fast = atomic_load_explicit(&fast_hits, memory_order_relaxed);
+  stats->slow = atomic_load_explicit(&fast_misses, memory_order_relaxed);
+}
+
+/**
+ * @brief Обнуление счетчиков быстрого пути
+ *
+ * @param Владимир
+ */
+void s21_reset_fast_stats(void) {
+  atomic_store_explicit(&fast_hits, 0, memory_order_relaxed);
+  atomic_store_explicit(&fast_misses, 0, memory_order_relaxed);
+}
+
+/**
+ * @brief Сложение двух чисел Decimal
+ *
+ * @param value_1 первое слагаемое
+ * @param value_2 второе слагаемое
+ * @param result результат сложения
+ * @param Владимир
+ * @return int возвращают код ошибки
+ */
+int s21_add(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
+  int sign2 = s21_bit(value_2, 127);
+  return s21_add_u64(value_1, value_2, sign2, result)
+             ? OK
+             : s21_add_big(value_1, value_2, sign2, result);
+}
+
+/**
+ * @brief Вычитание чисел Decimal
+ *
+ * @param value_1 первое число
+ * @param value_2 второе число
+ * @param result результат вычитания
+ * @param Владимир
+ * @return int возвращают код ошибки
+ */
+int s21_sub(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
+  int sign2 = !s21_bit(value_2, 127);
+  return s21_add_u64(value_1, value_2, sign2, result)
+             ? OK
+             : s21_add_big(value_1, value_2, sign2, result);
+}
+
+/**
+ * @brief Функция преобразует Decimal в десятичный вид в строку и выравнивает
+ * показатели степени
+ *
+ * @param value_1 первое число decimal
+ * @param value_2 второе число decimal
+ * @param val_1 первое число преобразованное в строку
+ * @param val_2 второе число преобразованное в строку
+ * @param Владимир
+ */
+void s21_str_scale(s21_decimal *value_1, s21_decimal *value_2, char *val_1,
+                   char *val_2) {
+  s21_mul_two_to_decimal(*value_1, val_1);
+  s21_mul_two_to_decimal(*value_2, val_2);
+  int scale1 = s21_scale(*value_1), scale2 = s21_scale(*value_2);
+  int scale = scale1 - scale2;
+  if (scale > 0) {
+    s21_shift_scale_str(val_2, scale);
+    value_2->bits[3] |= (s21_scale(*value_1) << 16);
+  }
+  if (scale < 0) {
+    s21_shift_scale_str(val_1, -scale);
+    value_1->bits[3] |= (s21_scale(*value_2) << 16);
+  }
+}
+
+/**
+ * @brief Модуль числа float, умноженный на 10 в степени scale, в длинном
+ * числе с округлением: mantisa * 2^exp * 10^scale
+ *
+ * @param mantisa мантисса float со скрытой единицей
+ * @param exp двоичный порядок мантиссы
+ * @param scale десятичная степень, может быть отрицательной
+ * @param flag способ округления модуля, как в s21_big_scale_down
+ * @param big указатель на длинное число для результата
+ * @param Владимир
+ */
+void s21_float_digits(uint32_t mantisa, int exp, int scale, int flag,
+                      s21_big_decimal *big) {
+  *big = (s21_big_decimal){{mantisa}};
+  if (scale >= 0) {
+    s21_big_scale_up(big, scale);
+    if (exp >= 0)
+      s21_big_shift_left(big, exp);
+    else
+      s21_big_shift_right(big, -exp, flag);
+  } else {
+    // scale < 0 только у чисел от 10^7, у них exp > 0
+    s21_big_shift_left(big, exp);
+    s21_big_scale_down(big, -scale, flag);
+  }
+}
+
+/**
+ * @brief Функция преобразования из типа float в тип Decimal. Число
+ * собирается прямо из битов IEEE-754 целочисленной арифметикой: по двоичному
+ * порядку оценивается десятичная степень, при которой в мантиссе остается
+ * FLOAT_ROUND значащих цифр, остальное бухгалтерски округляется
+ *
+ * @param src исходное число float
+ * @param dst указатель на число decimal, в которое сохраняем результат
+ * @param Владимир
+ * @return int 0 - OK, 1 - ошибка конвертации
+ */
+int s21_from_float_to_decimal(float src, s21_decimal *dst) {
+  int rezult = OK;
+  dst->bits[0] = dst->bits[1] = dst->bits[2] = dst->bits[3] = 0;
+  if (fabs(src) < FLOAT_MIN || isnan(src) || isinf(src)) {
+    rezult = ERROR;
+  } else {
+    uint32_t fl;
+    memcpy(&fl, &src, sizeof(uint32_t));
+    // от 1e-28 числа float нормализованы, скрытая единица всегда есть
+    uint32_t mantisa = (fl & 0x7fffffu) | 0x800000u;
+    int exp = (int)((fl >> 23) & 0xffu) - 150;
+    // 78913/2^18 чуть меньше log10(2): оценка снизу для порядка числа,
+    // ошибается не больше чем на единицу
+    int scale = FLOAT_ROUND - 1 - (((exp + 23) * 78913) >> 18);
+    if (scale > MAXEXP) scale = MAXEXP;
+    s21_big_decimal big, limit = {{pow10_bits[FLOAT_ROUND][0]}};
+    s21_float_digits(mantisa, exp, scale, ROUND_TRUNC, &big);
+    if (s21_big_cmp(&big, &limit) >= 0) scale--;
+    s21_float_digits(mantisa, exp, scale, ROUND_BANK, &big);
+    if (scale < 0) s21_big_scale_up(&big, -scale), scale = 0;
+    if (s21_big_round(&big, &scale, ROUND_BANK) == OK)
+      s21_from_big(&big, scale, fl >> 31, dst);
+    else
+      rezult = ERROR;
+  }
+  return rezult;
+}
+
+/**
+ * @brief Функция удаляет не значащие нули в начале строки и после запятой,
+ * уменьшая степень
+ *
+ * @param buffer строка с числом в десятичном виде
+ * @param buflen показатель степени
+ * @param Владимир
+ */
+void s21_buh_round_zero(char *buffer, int *buflen) {
+  int val_str = strlen(buffer) - 1;
+  while ((*buflen) > 0 && val_str > 0 && buffer[val_str] == '0')
+    val_str--, (*buflen)--;
+  buffer[val_str + 1] = '\0';
+  int i = 0;
+  while (buffer[i] == '0' && buffer[i + 1] != '\0') i++;
+  for (unsigned int j = 0; j < strlen(buffer) - i; j++)
+    buffer[j] = buffer[j + i];
+  buffer[strlen(buffer) - i] = '\0';
+}
+
+/**
+ * @brief Функция округляет пока нужно девятку изменить на ноль
+ *
+ * @param buffer строка с числом в десятичном виде
+ * @param buflen показатель степени
+ * @param val номер символа в строке, по который нужно обрезать
+ * @param Владимир
+ */
+int s21_buh_round_nine(char *buffer, int *buflen, int val) {
+  buffer[val] = '\0';
+  val--;
+  int res = 0;
+  while (buffer[val] == '9' && val > 0) buffer[val--] = '0';
+  if (val == 0 && buffer[val] == '9') {
+    buffer[0] = '0';
+    for (int j = strlen(buffer); j >= 0; j--) buffer[j + 1] = buffer[j];
+    buffer[0] = '1';
+    res = s21_buh_round(buffer, buflen, 0);
+  } else {
+    buffer[val]++;
+  }
+  return res;
+}
+
+/**
+ * @brief Функция бухгалтерского округления, попутно удаляет не значащие нули в
+ * начале строки и после запятой, уменьшая степень
+ *
+ * @param buffer строка с числом в десятичном виде
+ * @param buflen показатель степени
+ * @param flag 0-бухгалтерское огругление; 1-округление до 7 значащих цифр;
+ * 2-простое округление
+ * @param Владимир
+ * @return int возвращает ОК или INF при числе выходящим за границы Decimal
+ */
+int s21_buh_round(char *buffer, int *buflen, int flag) {
+  int rez = OK;
+  s21_buh_round_zero(buffer, buflen);
+  int val = strlen(buffer);
+  if (val - *buflen <= MAXDEC && *buflen - val <= MAXEXP) {
+    if (*buflen > 28) val -= *buflen - MAXEXP, *buflen = MAXEXP;
+    if (val > 29) *buflen -= (val - MAXDEC), val = MAXDEC;
+    if (val > 0 && *buflen >= 0) {
+      if (flag == 1 && val > FLOAT_ROUND) {
+        for (int j = FLOAT_ROUND + 1; j < (int)strlen(buffer); j++)
+          buffer[j] = '0';
+        flag = 0;
+        *buflen =
+            (*buflen - val + FLOAT_ROUND > 0) ? *buflen - val + FLOAT_ROUND : 0;
+        val = FLOAT_ROUND;
+        // flag=2; если все таки нужно простое округление на флоате
+      }
+      if (buffer[val] > '5' ||
+          (buffer[val] == '5' &&
+           ((buffer[val - 1] % 2 == 1 && flag == 0) || flag == 2))) {
+        if (buffer[val - 1] == '9')
+          rez = s21_buh_round_nine(buffer, buflen, val);
+        else
+          buffer[val - 1]++, buffer[val] = '0';
+      }
+      if (*buflen > 0 || val == 29) buffer[val] = '\0';
+      s21_buh_round_zero(buffer, buflen);
     }
     if (*buflen <= 0 && !rez) {
       val -= *buflen, *buflen = 0;
@@ -394,232 +1113,1073 @@ int s21_buh_round(char *buffer, int *buflen, int flag) {
 }
 
 /**
- * @brief Функция деления десятичного числа на 2, для преобразования его в
- * двоичный код
+ * @brief Функция деления десятичного числа на 2, для преобразования его в
+ * двоичный код
+ *
+ * @param dst указатель на число децимал для записи результата деления
+ * @param buffer строка с десятичным числом
+ * @param Владимир
+ */
+void s21_div_decimal_to_two(s21_decimal *dst, char *buffer) {
+  int binar = 0, bit = 0;
+  while (strcspn(buffer, ".123456789") != strlen(buffer)) {
+    int binar_val = 0;
+    for (unsigned int j = 0; j < strlen(buffer); j++) {
+      int q = 0;
+      if (binar_val == 1) q = 10;
+      binar_val = ((buffer[j] - '0') + q) % 2;
+      buffer[j] = (((buffer[j] - '0') + q) / 2) + '0';
+    }
+    if (binar == 32) binar = 0, bit++;
+    if (binar_val) s21_toggle_bit(dst, 32 * bit + binar);
+    binar++;
+  }
+}
+
+/**
+ * @brief Функция умножения двоичного числа на 2, для преобразования его в
+ * десятичное
+ *
+ * @param src указатель на число децимал
+ * @param buffer строка для сохранения десятичного числа
+ * @param Владимир
+ */
+void s21_mul_two_to_decimal(const s21_decimal src, char *buffer) {
+  int bit = 2;
+  for (int j = 32; bit > -1; j--) {
+    for (int i = MAXSTR - 2, one = 0; i > 0; i--) {
+      int temp = (buffer[i] - '0') * 2 + one;
+      one = (temp > 9) ? 1 : 0;
+      if (temp > 9) temp -= 10;
+      buffer[i] = temp + '0';
+    }
+    buffer[MAXSTR - 2] =
+        ((buffer[MAXSTR - 2] - '0') + s21_bit(src, 32 * bit + j)) + '0';
+    if (j == 0) j = 32, bit--;
+  }
+}
+
+/**
+ * @brief Точное деление длинного числа на 10^scale с округлением частного до
+ * prec значащих битов: частное берется с запасом в два бита, ненулевой
+ * остаток записывается в младший бит и решает округление ровно на половине
+ *
+ * @param big указатель на длинное число, не больше 96 бит
+ * @param scale показатель степени, не больше 56
+ * @param prec количество значащих битов результата, не больше 53
+ * @param Владимир
+ * @return double модуль числа, точно представленный prec битами
+ */
+double s21_big_to_binary(const s21_big_decimal *big, int scale, int prec) {
+  double rez = 0.0;
+  if (!s21_big_is_zero(big)) {
+    s21_big_decimal num = *big, den = {{1}}, rem;
+    s21_big_scale_up(&den, scale);
+    int shift = prec + 2 - (s21_big_bits(&num) - s21_big_bits(&den));
+    if (shift > 0) s21_big_shift_left(&num, shift);
+    if (shift < 0) s21_big_shift_left(&den, -shift);
+    s21_big_divmod(&num, &den, &num, &rem);
+    if (!s21_big_is_zero(&rem)) num.bits[0] |= 1u;
+    int drop = s21_big_bits(&num) - prec;
+    s21_big_shift_right(&num, drop, ROUND_BANK);
+    rez = ldexp((double)num.bits[0] + ldexp(num.bits[1], 32), drop - shift);
+  }
+  return rez;
+}
+
+/**
+ * @brief Преобразование Decimal в двоичное число с плавающей точкой с
+ * округлением до prec значащих битов. Мантисса до 2^53 и степень до 22
+ * делятся прямо в double, одно деление точных чисел округляется правильно.
+ * Для float такое частное округляется второй раз, и если оно попало ровно
+ * на середину между соседними float, а также для остальных чисел, результат
+ * считается точно в длинных числах
+ *
+ * @param src число Decimal
+ * @param prec количество значащих битов: FLT_MANT_DIG или DBL_MANT_DIG
+ * @param Владимир
+ * @return double результат, 0 для степени больше 56
+ */
+double s21_decimal_to_binary(s21_decimal src, int prec) {
+  double rez = 0.0;
+  int scale = s21_scale(src), exact = 0;
+  uint64_t low = (uint32_t)src.bits[0] | (uint64_t)(uint32_t)src.bits[1] << 32;
+  if (!src.bits[2] && !(low >> DBL_MANT_DIG) && scale <= 22) {
+    rez = (double)low / pow10_dbl[scale];
+    uint64_t raw;
+    memcpy(&raw, &rez, sizeof(uint64_t));
+    uint64_t tail = (1ULL << (DBL_MANT_DIG - prec)) - 1;
+    exact = prec == DBL_MANT_DIG || (raw & tail) != (tail + 1) / 2;
+  }
+  if (!exact && scale <= 2 * MAXEXP) {
+    s21_big_decimal big;
+    s21_to_big(src, &big);
+    rez = s21_big_to_binary(&big, scale, prec);
+  }
+  if (s21_bit(src, 127)) rez = -rez;
+  return rez;
+}
+
+/**
+ * @brief Функция преобразование из типа Decimal в тип Float
+ *
+ * @param src число Decimal, которое нужно преобразовать
+ * @param dst указатель на число float, куда сохранить результат
+ * преобразования
+ * @param Владимир
+ * @return int 0 - OK, 1 - ошибка конвертации
+ */
+int s21_from_decimal_to_float(s21_decimal src, float *dst) {
+  int rezult = OK;
+  *dst = (float)s21_decimal_to_binary(src, FLT_MANT_DIG);
+  if (fabs(*dst) < FLOAT_MIN || isinf(*dst)) rezult = ERROR, *dst = 0.0;
+  return rezult;
+}
+
+/**
+ * @brief Функция преобразование из типа Decimal в тип Double
+ *
+ * @param src число Decimal, которое нужно преобразовать
+ * @param dst указатель на число double, куда сохранить результат
+ * преобразования
+ * @param Владимир
+ * @return int 0 - OK, 1 - ошибка конвертации
+ */
+int s21_from_decimal_to_double(s21_decimal src, double *dst) {
+  int rezult = OK;
+  *dst = s21_decimal_to_binary(src, DBL_MANT_DIG);
+  if (fabs(*dst) < FLOAT_MIN || isinf(*dst)) rezult = ERROR, *dst = 0.0;
+  return rezult;
+}
+
+/**
+ * @brief Побитовый сдвиг вправо
+ *
+ * @param value указатель на число децимал
+ * @param num количество сдвигаемых битов
+ * @param Владимир
+ */
+void s21_shift_bits_right(s21_decimal *value, const int num) {
+  for (int j = 0; j < num; j++) {
+    value->bits[0] >>= 1;
+    if (s21_bit(*value, 31) != s21_bit(*value, 32)) s21_toggle_bit(value, 31);
+    value->bits[1] >>= 1;
+    if (s21_bit(*value, 63) != s21_bit(*value, 64)) s21_toggle_bit(value, 63);
+    value->bits[2] >>= 1;
+    if (s21_bit(*value, 95)) s21_toggle_bit(value, 95);
+  }
+}
+
+/**
+ * @brief Побитовый сдвиг влево
+ *
+ * @param value указатель на число децимал
+ * @param num количество сдвигаемых битов
+ * @param Владимир
+ * @return int код ошибки
+ */
+int s21_shift_bits_left(s21_decimal *value, const int num) {
+  int rez = OK;
+  for (int j = 0; j < num; j++) {
+    value->bits[2] <<= 1;
+    if (s21_bit(*value, 63) != s21_bit(*value, 64)) s21_toggle_bit(value, 64);
+    value->bits[1] <<= 1;
+    if (s21_bit(*value, 31) != s21_bit(*value, 32)) s21_toggle_bit(value, 32);
+    value->bits[0] <<= 1;
+  }
+  return rez;
+}
+
+/**
+ * @brief Подсчет количества битов
+ *
+ * @param value указатель на число децимал
+ * @param Владимир
+ * @return int количество
+ */
+int s21_sum_bits(s21_decimal *value) {
+  int end = 0;
+  for (int i = 96; i >= 0; i--) {
+    if (s21_bit(*value, i) == 1) {
+      end = i + 1;
+      i = -1;
+    }
+  }
+  return end;
+}
+
+/**
+ * @brief Целая часть модуля числа Decimal в длинном числе: деление на
+ * 10^scale с округлением
+ *
+ * @param src число децимал
+ * @param flag способ округления, как в s21_rescale
+ * @param big указатель на длинное число для результата
+ * @param Владимир
+ */
+void s21_big_integer(s21_decimal src, int flag, s21_big_decimal *big) {
+  int scale = s21_scale(src);
+  if (s21_bit(src, 127) && (flag == ROUND_FLOOR || flag == ROUND_CEIL))
+    flag = flag == ROUND_FLOOR ? ROUND_CEIL : ROUND_FLOOR;
+  s21_to_big(src, big);
+  if (scale > 0) s21_big_scale_down(big, scale, flag);
+}
+
+/**
+ * @brief Из int в децимал
+ *
+ * @param dst указатель на число децимал
+ * @param src десятичное целое число
+ * @param Никита
+ * @return int код ошибки: -2147483648 по-прежнему считается ошибкой, хотя
+ * значение записывается
+ */
+int s21_from_int_to_decimal(int src, s21_decimal *dst) {
+  s21_from_int64_to_decimal(src, dst);
+  return src < -MAXINT ? ERROR : OK;
+}
+
+/**
+ * @brief Из int64 в децимал, модуль записывается прямо в слова мантиссы
+ *
+ * @param src целое число
+ * @param dst указатель на число децимал
+ * @param Владимир
+ * @return int код ошибки, всегда OK
+ */
+int s21_from_int64_to_decimal(int64_t src, s21_decimal *dst) {
+  uint64_t abs = src < 0 ? 0 - (uint64_t)src : (uint64_t)src;
+  s21_big_decimal big = {{(uint32_t)abs, (uint32_t)(abs >> 32)}};
+  s21_from_big(&big, 0, src < 0, dst);
+  return OK;
+}
+
+/**
+ * @brief Из uint64 в децимал
+ *
+ * @param src целое число без знака
+ * @param dst указатель на число децимал
+ * @param Владимир
+ * @return int код ошибки, всегда OK
+ */
+int s21_from_uint64_to_decimal(uint64_t src, s21_decimal *dst) {
+  s21_big_decimal big = {{(uint32_t)src, (uint32_t)(src >> 32)}};
+  s21_from_big(&big, 0, 0, dst);
+  return OK;
+}
+
+/**
+ * @brief Из децимал в int, дробная часть отбрасывается
+ *
+ * @param dst указатель на десятичное целое число
+ * @param src число децимал
+ * @param Никита
+ * @return int код ошибки
+ */
+int s21_from_decimal_to_int(s21_decimal src, int *dst) {
+  int64_t val = 0;
+  int rez = s21_from_decimal_to_int64(src, &val);
+  if (rez || val > MAXINT || val < -MAXINT - 1LL) val = 0, rez = ERROR;
+  *dst = (int)val;
+  return rez;
+}
+
+/**
+ * @brief Из децимал в int64, дробная часть отбрасывается
+ *
+ * @param src число децимал
+ * @param dst указатель на целое число, 0 при ошибке
+ * @param Владимир
+ * @return int код ошибки: ERROR, если целая часть не помещается в int64
+ */
+int s21_from_decimal_to_int64(s21_decimal src, int64_t *dst) {
+  int rez = OK, sign = s21_bit(src, 127);
+  s21_big_decimal big;
+  s21_big_integer(src, ROUND_TRUNC, &big);
+  uint64_t abs = big.bits[0] | (uint64_t)big.bits[1] << 32;
+  *dst = 0;
+  if (big.bits[2] || abs > (uint64_t)INT64_MAX + sign)
+    rez = ERROR;
+  else if (abs)
+    *dst = sign ? -(int64_t)(abs - 1) - 1 : (int64_t)abs;
+  return rez;
+}
+
+/**
+ * @brief Из децимал в uint64, дробная часть отбрасывается
+ *
+ * @param src число децимал
+ * @param dst указатель на целое число без знака, 0 при ошибке
+ * @param Владимир
+ * @return int код ошибки: ERROR для отрицательных чисел с ненулевой целой
+ * частью и для чисел больше 2^64 - 1
+ */
+int s21_from_decimal_to_uint64(s21_decimal src, uint64_t *dst) {
+  int rez = OK;
+  s21_big_decimal big;
+  s21_big_integer(src, ROUND_TRUNC, &big);
+  uint64_t abs = big.bits[0] | (uint64_t)big.bits[1] << 32;
+  *dst = 0;
+  if (big.bits[2] || (abs && s21_bit(src, 127)))
+    rez = ERROR;
+  else
+    *dst = abs;
+  return rez;
+}
+
+#ifdef __SIZEOF_INT128__
+/**
+ * @brief Из unsigned __int128 в децимал
+ *
+ * @param src целое число без знака
+ * @param dst указатель на число децимал
+ * @param Владимир
+ * @return int код ошибки: ERROR для чисел от 2^96, dst тогда равен 0
+ */
+int s21_from_uint128_to_decimal(unsigned __int128 src, s21_decimal *dst) {
+  int rez = src >> 96 ? ERROR : OK;
+  *dst = dec_null;
+  for (int i = 0; i < 3 && !rez; i++)
+    dst->bits[i] = (int)(uint32_t)(src >> 32 * i);
+  return rez;
+}
+
+/**
+ * @brief Из децимал в unsigned __int128, дробная часть отбрасывается
+ *
+ * @param src число децимал
+ * @param dst указатель на целое число без знака, 0 при ошибке
+ * @param Владимир
+ * @return int код ошибки: ERROR для отрицательных чисел с ненулевой целой
+ * частью
+ */
+int s21_from_decimal_to_uint128(s21_decimal src, unsigned __int128 *dst) {
+  int rez = OK;
+  s21_big_decimal big;
+  s21_big_integer(src, ROUND_TRUNC, &big);
+  *dst = 0;
+  if (!s21_big_is_zero(&big) && s21_bit(src, 127))
+    rez = ERROR;
+  else
+    for (int i = 2; i >= 0; i--) *dst = *dst << 32 | big.bits[i];
+  return rez;
+}
+#endif
+
+/**
+ * @brief Перенос накопленных в chunk цифр в длинное число умножением на
+ * 10^len не больше чем двумя словами. Пока все цифры в chunk, длинное
+ * число нулевое и просто принимает chunk
+ *
+ * @param st указатель на состояние разбора
+ * @param Владимир
+ */
+void s21_parse_fold(s21_parse_state *st) {
+  if (st->len) {
+    s21_big_decimal add = {{(uint32_t)st->chunk, (uint32_t)(st->chunk >> 32)}};
+    if (st->digits == st->len) {
+      st->big = add;
+    } else {
+      s21_big_mul_word(&st->big, pow10_bits[st->len > 9 ? 9 : st->len][0]);
+      if (st->len > 9) s21_big_mul_word(&st->big, pow10_bits[st->len - 9][0]);
+      s21_big_add(&st->big, &add, &st->big);
+    }
+    st->chunk = 0;
+    st->len = 0;
+  }
+}
+
+/**
+ * @brief Разбор до 8 цифр за шаг в 64-битном слове (SWAR): признак
+ * не-цифры ищется сразу во всех байтах, цифры собираются тремя
+ * умножениями. Байты после первой не-цифры не используются, поэтому
+ * переносы между ними не мешают
+ *
+ * @param p 8 доступных байтов текста
+ * @param val значение первых цифр
+ * @param Владимир
+ * @return int количество цифр подряд с начала, от 0 до 8
+ */
+int s21_parse_eight(const char *p, uint32_t *val) {
+  uint64_t x;
+  memcpy(&x, p, sizeof(x));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  x = __builtin_bswap64(x);
+#endif
+  const uint64_t high = 0xf0f0f0f0f0f0f0f0ULL, zero = 0x3030303030303030ULL;
+  uint64_t bad = ((x & high) ^ zero) | (((x + 0x0606060606060606ULL) & high) ^
+                                        zero);
+  int n = bad ? __builtin_ctzll(bad) >> 3 : 8;
+  if (n) {
+    uint64_t digits = x - zero;
+    // неполный блок сдвигается к старшим байтам, впереди встают нули
+    if (n < 8) digits = (digits & ((1ULL << 8 * n) - 1)) << 8 * (8 - n);
+    digits = digits * 10 + (digits >> 8);
+    digits = ((digits & 0x000000ff000000ffULL) * (100 + (1000000ULL << 32)) +
+              ((digits >> 16) & 0x000000ff000000ffULL) *
+                  (1 + (10000ULL << 32))) >>
+             32;
+    *val = (uint32_t)digits;
+  }
+  return n;
+}
+
+#ifdef S21_X86_SIMD
+/**
+ * @brief Разбор 16 цифр за шаг на SSE4.1: пары, четверки и восьмерки цифр
+ * собираются умножениями со сложением соседей
+ *
+ * @param p 16 доступных байтов текста
+ * @param val значение 16 цифр
+ * @param Владимир
+ * @return int 16, если все байты цифры, иначе 0
+ */
+__attribute__((target("sse4.1"))) int s21_parse_sixteen(const char *p,
+                                                        uint64_t *val) {
+  __m128i digits = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)p),
+                                _mm_set1_epi8('0'));
+  __m128i nine = _mm_min_epu8(digits, _mm_set1_epi8(9));
+  int n = 0;
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(nine, digits)) == 0xffff) {
+    __m128i pair = _mm_maddubs_epi16(
+        digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1,
+                              10, 1));
+    __m128i quad =
+        _mm_madd_epi16(pair, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+    quad = _mm_packus_epi32(quad, quad);
+    __m128i eight = _mm_madd_epi16(
+        quad, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+    *val = (uint64_t)(uint32_t)_mm_cvtsi128_si32(eight) * 100000000 +
+           (uint32_t)_mm_extract_epi32(eight, 1);
+    n = 16;
+  }
+  return n;
+}
+#endif
+
+/**
+ * @brief Разбор подряд идущих цифр целой или дробной части. После первой
+ * значащей цифры цифры берутся блоками: по 16 на SSE4.1 (при уровне
+ * s21_simd_level от SIMD_AVX2) и до 8 в 64-битном слове, пока в буфере
+ * есть 8 байтов; остаток разбирается по одной цифре. Ведущие нули не
+ * считаются значащими, цифры после PARSE_DIGITS значащих сдвигают степень
+ * (в целой части) и попадают в признак ненулевого хвоста
+ *
+ * @param p начало цифр
+ * @param last конец буфера
+ * @param st указатель на состояние разбора
+ * @param frac 1 - дробная часть, 0 - целая
+ * @param level уровень векторных ядер
+ * @param Владимир
+ * @return const char* первый символ после цифр
+ */
+const char *s21_parse_run(const char *p, const char *last,
+                          s21_parse_state *st, int frac, int level) {
+  int run = 1;
+  while (run && p < last) {
+    int n = 0;
+    uint64_t block = 0;
+    if ((st->digits || *p != '0') && last - p >= 8) {
+#ifdef S21_X86_SIMD
+      if (level >= SIMD_AVX2 && last - p >= 16 &&
+          st->digits + 16 <= PARSE_DIGITS)
+        n = s21_parse_sixteen(p, &block);
+#endif
+      if (!n) {
+        uint32_t eight = 0;
+        n = s21_parse_eight(p, &eight);
+        block = eight;
+        // после неполного блока цифры кончились
+        if (n < 8) run = 0;
+        if (st->digits + n > PARSE_DIGITS) n = 0, run = 1;
+      }
+    }
+    if (n) {
+      if (st->len + n > 18) s21_parse_fold(st);
+      st->chunk = st->chunk * pow10_u64[n] + block;
+      if ((st->len += n) == 18) s21_parse_fold(st);
+      st->digits += n;
+      st->exp -= frac * n;
+      st->any = 1;
+      p += n;
+    } else if ((unsigned)(*p - '0') < 10) {
+      uint32_t digit = (uint32_t)(*p++ - '0');
+      st->any = 1;
+      if (!st->digits && !digit) {
+        st->exp -= frac;
+      } else if (st->digits < PARSE_DIGITS) {
+        st->chunk = st->chunk * 10 + digit;
+        st->digits++;
+        st->exp -= frac;
+        if (++st->len == 18) s21_parse_fold(st);
+      } else {
+        st->exp += !frac;
+        st->sticky |= digit != 0;
+      }
+    } else {
+      run = 0;
+    }
+  }
+#ifndef S21_X86_SIMD
+  (void)level;
+#endif
+  return p;
+}
+
+/**
+ * @brief Разбор экспоненты вида e-12. Без цифр после e экспонента не
+ * разбирается и указатель не сдвигается
+ *
+ * @param p указатель на текущую позицию
+ * @param last конец буфера
+ * @param Владимир
+ * @return int показатель, по модулю не больше примерно 10 * PARSE_EXP
+ */
+int s21_parse_exp(const char **p, const char *last) {
+  const char *q = *p;
+  int exp = 0, sign = 0;
+  if (q < last && (*q == 'e' || *q == 'E')) {
+    q++;
+    if (q < last && (*q == '-' || *q == '+')) sign = *q++ == '-';
+    if (q < last && (unsigned)(*q - '0') < 10) {
+      for (; q < last && (unsigned)(*q - '0') < 10; q++)
+        if (exp < PARSE_EXP) exp = exp * 10 + (*q - '0');
+      *p = q;
+    }
+  }
+  return sign ? -exp : exp;
+}
+
+/**
+ * @brief Запись разобранного числа big * 10^exp в Decimal: лишние цифры
+ * дроби округляются бухгалтерским способом один раз, ненулевой хвост за
+ * PARSE_DIGITS цифрами добавляется единицей в следующий разряд, чтобы
+ * половина отличалась от чуть большего значения
+ *
+ * @param big указатель на значащие цифры, изменяется
+ * @param exp десятичный показатель
+ * @param sticky признак ненулевых отброшенных цифр
+ * @param sign знак
+ * @param out результат
+ * @param Владимир
+ * @return int код ошибки
+ */
+int s21_parse_finish(s21_big_decimal *big, int exp, int sticky, int sign,
+                     s21_decimal *out) {
+  int ret = OK, scale = 0;
+  if (s21_big_is_zero(big)) {
+    *big = (s21_big_decimal){{0}};
+  } else if (exp >= 0) {
+    // хотя бы одна значащая цифра: 10^29 уже больше 2^96
+    if (exp > MAXDEC) {
+      ret = INF;
+    } else {
+      s21_big_scale_up(big, exp);
+      if (!s21_big_fits(big)) ret = INF;
+    }
+  } else {
+    // меньше половины единицы 28-го знака при любом big
+    scale = -exp > MAXEXP + PARSE_DIGITS + 1 ? MAXEXP + PARSE_DIGITS + 1
+                                             : -exp;
+    if (sticky) {
+      s21_big_decimal one = {{1}};
+      s21_big_mul_word(big, 10);
+      s21_big_add(big, &one, big);
+      scale++;
+    }
+    ret = s21_big_fit(big, &scale, ROUND_BANK);
+  }
+  *out = dec_null;
+  if (ret == OK)
+    s21_from_big(big, scale, sign, out);
+  else if (sign)
+    ret = NEGATIVE_INF, out->bits[3] = MINUS;
+  return ret;
+}
+
+/**
+ * @brief Разбор числа из текста [first, last) без завершающего нуля и без
+ * выделения памяти: знак, цифры с точкой, экспонента вида 1.5e-3. Степень
+ * из записи сохраняется, лишние цифры дроби округляются бухгалтерским
+ * способом
+ *
+ * @param first начало текста
+ * @param last конец текста
+ * @param out результат
+ * @param Владимир
+ * @return s21_from_chars_result конец числа и код ошибки: OK, INF и
+ * NEGATIVE_INF при переполнении, s21_NAN если числа нет (ptr равен first)
+ */
+s21_from_chars_result s21_from_chars(const char *first, const char *last,
+                                     s21_decimal *out) {
+  s21_from_chars_result rez = {first, s21_NAN};
+  s21_parse_state st = {.any = 0};
+  const char *p = first;
+  int sign = 0, level = s21_simd_level();
+  if (p < last && (*p == '-' || *p == '+')) sign = *p++ == '-';
+  p = s21_parse_run(p, last, &st, 0, level);
+  if (p < last && *p == '.') p = s21_parse_run(p + 1, last, &st, 1, level);
+  *out = dec_null;
+  if (st.any) {
+    int exp = st.exp + s21_parse_exp(&p, last);
+    rez.ptr = p;
+    if (st.digits == st.len && exp <= 0 && exp >= -MAXEXP) {
+      // все цифры в одном 64-битном слове и степень допустима
+      out->bits[0] = (int)(uint32_t)st.chunk;
+      out->bits[1] = (int)(uint32_t)(st.chunk >> 32);
+      out->bits[3] = st.chunk ? (-exp << 16) | (sign ? MINUS : PLUS) : 0;
+      rez.error = OK;
+    } else {
+      s21_parse_fold(&st);
+      rez.error = s21_parse_finish(&st.big, exp, st.sticky, sign, out);
+    }
+  }
+  return rez;
+}
+
+/**
+ * @brief Цифры мантиссы без ведущих нулей: 96-битная мантисса делится на
+ * 10^9, пока не поместится в 32 бита, каждый остаток дает 9 цифр, цифры
+ * пишутся парами из digit_pairs
+ *
+ * @param value число
+ * @param end конец буфера не меньше MAXDEC символов, цифры пишутся перед ним
+ * @param Владимир
+ * @return int количество цифр, у нуля одна цифра
+ */
+int s21_chars_digits(s21_decimal value, char *end) {
+  uint64_t hi = (uint32_t)value.bits[2];
+  uint64_t lo =
+      (uint64_t)(uint32_t)value.bits[1] << 32 | (uint32_t)value.bits[0];
+  char *p = end;
+  while (hi || lo >= 1000000000) {
+    uint32_t rem;
+    if (hi) {
+      // деление по 32-битным словам, остаток переходит в следующее слово
+      uint64_t mid = (hi % 1000000000) << 32 | lo >> 32;
+      hi /= 1000000000;
+      uint64_t low = (mid % 1000000000) << 32 | (uint32_t)lo;
+      lo = (mid / 1000000000) << 32 | low / 1000000000;
+      rem = (uint32_t)(low % 1000000000);
+    } else {
+      rem = (uint32_t)(lo % 1000000000);
+      lo /= 1000000000;
+    }
+    for (int k = 0; k < 4; k++, rem /= 100)
+      memcpy(p -= 2, digit_pairs + 2 * (rem % 100), 2);
+    *--p = (char)('0' + rem);
+  }
+  uint32_t top = (uint32_t)lo;
+  for (; top >= 100; top /= 100)
+    memcpy(p -= 2, digit_pairs + 2 * (top % 100), 2);
+  if (top >= 10)
+    memcpy(p -= 2, digit_pairs + 2 * top, 2);
+  else
+    *--p = (char)('0' + top);
+  return (int)(end - p);
+}
+
+/**
+ * @brief Запись числа текстом в буфер [first, last) с заданным количеством
+ * знаков после точки: лишние знаки округляются половиной от нуля, как в
+ * s21_round, недостающие дописываются нулями. Без места в буфере ничего
+ * не записывается
+ *
+ * @param first начало буфера
+ * @param last конец буфера
+ * @param value число
+ * @param precision знаков после точки или CHARS_SHORTEST - кратчайшая
+ * запись, точно равная числу
+ * @param Владимир
+ * @return s21_to_chars_result конец записи и код ошибки: ERROR, если
+ * буфер мал, степень числа больше MAXEXP или точность меньше CHARS_SHORTEST
+ */
+s21_to_chars_result s21_to_chars_fixed(char *first, char *last,
+                                       s21_decimal value, int precision) {
+  s21_to_chars_result rez = {last, ERROR};
+  int scale = s21_scale(value);
+  if (scale >= 0 && scale <= MAXEXP && precision >= CHARS_SHORTEST) {
+    if (precision >= 0 && precision < scale) {
+      s21_big_decimal big = {{(uint32_t)value.bits[0], (uint32_t)value.bits[1],
+                              (uint32_t)value.bits[2]}};
+      s21_big_scale_down(&big, scale - precision, ROUND_HALF_UP);
+      for (int i = 0; i < 3; i++) value.bits[i] = (int)big.bits[i];
+      scale = precision;
+    }
+    char digits[MAXDEC];
+    int len = s21_chars_digits(value, digits + MAXDEC);
+    const char *d = digits + MAXDEC - len;
+    int frac = precision;
+    if (precision < 0) {
+      // у нуля остается одна цифра
+      for (; scale && d[len - 1] == '0'; scale--)
+        if (len > 1) len--;
+      frac = scale;
+    }
+    int whole = len > scale ? len - scale : 0;
+    int minus = (value.bits[3] & MINUS) && (len > 1 || d[0] != '0');
+    ptrdiff_t total = minus + (whole ? whole : 1) + (frac ? frac + 1 : 0);
+    if (total <= last - first) {
+      char *p = first;
+      if (minus) *p++ = '-';
+      if (whole) {
+        memcpy(p, d, whole);
+        p += whole;
+      } else {
+        *p++ = '0';
+      }
+      if (frac) {
+        *p++ = '.';
+        // нули между точкой и цифрами мантиссы, затем нули до точности
+        memset(p, '0', scale - (len - whole));
+        p += scale - (len - whole);
+        memcpy(p, d + whole, len - whole);
+        p += len - whole;
+        memset(p, '0', frac - scale);
+        p += frac - scale;
+      }
+      rez.ptr = p;
+      rez.error = OK;
+    }
+  }
+  return rez;
+}
+
+/**
+ * @brief Кратчайшая точная запись числа текстом в буфер [first, last):
+ * степень числа не сохраняется, нули в конце дробной части отбрасываются
+ *
+ * @param first начало буфера
+ * @param last конец буфера
+ * @param value число
+ * @param Владимир
+ * @return s21_to_chars_result конец записи и код ошибки
+ */
+s21_to_chars_result s21_to_chars(char *first, char *last, s21_decimal value) {
+  return s21_to_chars_fixed(first, last, value, CHARS_SHORTEST);
+}
+
+/**
+ * @brief Умножение двух чисел Decimal
+ *
+ * @param value_1 первой множитель
+ * @param value_2 второй множитель
+ * @param result результат умножения
+ * @param Андрей
+ * @return int возвращают код ошибки
+ */
+int s21_mul(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
+  int flag = OK;
+  if (!s21_mul_u64(value_1, value_2, result)) {
+    atomic_fetch_add_explicit(&fast_misses, 1, memory_order_relaxed);
+    int sign = s21_bit(value_1, 127) ^ s21_bit(value_2, 127);
+    int exp_res = s21_scale(value_1) + s21_scale(value_2);
+    s21_big_decimal res;
+    s21_mul_words(value_1, value_2, &res);
+    flag = s21_big_round(&res, &exp_res, ROUND_BANK);
+    if (flag == OK)
+      s21_from_big(&res, exp_res, sign, result);
+    else if (sign)
+      flag = NEGATIVE_INF;
+  }
+  return flag;
+}
+
+/**
+ * @brief Умножение со сложением value_1 * value_2 + value_3 с одним
+ * округлением: произведение остается точным в 192 битах, третье число
+ * выравнивается по степени и округляется только сумма
  *
- * @param dst указатель на число децимал для записи результата деления
- * @param buffer строка с десятичным числом
+ * @param value_1 первый множитель
+ * @param value_2 второй множитель
+ * @param value_3 слагаемое
+ * @param result результат
  * @param Владимир
+ * @return int возвращают код ошибки
  */
-void s21_div_decimal_to_two(s21_decimal *dst, char *buffer) {
-  int binar = 0, bit = 0;
-  while (strcspn(buffer, ".123456789") != strlen(buffer)) {
-    int binar_val = 0;
-    for (unsigned int j = 0; j < strlen(buffer); j++) {
-      int q = 0;
-      if (binar_val == 1) q = 10;
-      binar_val = ((buffer[j] - '0') + q) % 2;
-      buffer[j] = (((buffer[j] - '0') + q) / 2) + '0';
-    }
-    if (binar == 32) binar = 0, bit++;
-    if (binar_val) s21_toggle_bit(dst, 32 * bit + binar);
-    binar++;
+int s21_fma(s21_decimal value_1, s21_decimal value_2, s21_decimal value_3,
+            s21_decimal *result) {
+  s21_big_decimal prod, big_3;
+  s21_mul_words(value_1, value_2, &prod);
+  s21_to_big(value_3, &big_3);
+  return s21_big_sum(&prod, s21_scale(value_1) + s21_scale(value_2),
+                     s21_bit(value_1, 127) ^ s21_bit(value_2, 127), &big_3,
+                     s21_scale(value_3), s21_bit(value_3, 127), result);
+}
+
+/**
+ * @brief Обнуление точного сумматора: корзины обнуляются при первом
+ * обращении
+ *
+ * @param acc указатель на сумматор
+ * @param Владимир
+ */
+void s21_acc_init(s21_accumulator *acc) { acc->used = 0; }
+
+/**
+ * @brief Корзина сумматора для степени scale, обнуляется при первом
+ * обращении
+ *
+ * @param acc указатель на сумматор
+ * @param scale степень от 0 до ACC_SCALE
+ * @param Владимир
+ * @return s21_big_decimal* указатель на корзину
+ */
+s21_big_decimal *s21_acc_bucket(s21_accumulator *acc, int scale) {
+  if (!(acc->used >> scale & 1u)) {
+    acc->bucket[scale] = (s21_big_decimal){{0}};
+    acc->used |= 1ULL << scale;
   }
+  return &acc->bucket[scale];
 }
 
 /**
- * @brief Функция умножения двоичного числа на 2, для преобразования его в
- * десятичное
+ * @brief Точное прибавление модуля со знаком к корзине его степени. Модуль
+ * до 2^192, корзина в 384 бита вмещает 2^190 таких слагаемых
  *
- * @param src указатель на число децимал
- * @param buffer строка для сохранения десятичного числа
+ * @param acc указатель на сумматор
+ * @param big указатель на модуль слагаемого, изменяется
+ * @param scale степень слагаемого
+ * @param sign знак слагаемого: 0 - плюс, 1 - минус
  * @param Владимир
  */
-void s21_mul_two_to_decimal(const s21_decimal src, char *buffer) {
-  int bit = 2;
-  for (int j = 32; bit > -1; j--) {
-    for (int i = MAXSTR - 2, one = 0; i > 0; i--) {
-      int temp = (buffer[i] - '0') * 2 + one;
-      one = (temp > 9) ? 1 : 0;
-      if (temp > 9) temp -= 10;
-      buffer[i] = temp + '0';
-    }
-    buffer[MAXSTR - 2] =
-        ((buffer[MAXSTR - 2] - '0') + s21_bit(src, 32 * bit + j)) + '0';
-    if (j == 0) j = 32, bit--;
+void s21_acc_add_big(s21_accumulator *acc, s21_big_decimal *big, int scale,
+                     int sign) {
+  if (scale > ACC_SCALE) {
+    s21_big_scale_down(big, scale - ACC_SCALE, ROUND_BANK);
+    scale = ACC_SCALE;
   }
+  s21_big_decimal *bucket = s21_acc_bucket(acc, scale);
+  if (sign)
+    s21_big_sub(bucket, big, bucket);
+  else
+    s21_big_add(bucket, big, bucket);
 }
 
 /**
- * @brief Функция преобразование из типа Decimal в тип Float
+ * @brief Точное прибавление числа Decimal к сумматору, без округления
  *
- * @param src число Decimal, которое нужно преобразовать
- * @param dst указатель на число float, куда сохранить результат
- * преобразования
+ * @param acc указатель на сумматор
+ * @param value слагаемое
  * @param Владимир
- * @return int 0 - OK, 1 - ошибка конвертации
  */
-int s21_from_decimal_to_float(s21_decimal src, float *dst) {
-  char buffer[MAXSTR];
-  s21_init(buffer);
-  int rezult = OK;
-  s21_mul_two_to_decimal(src, buffer);
-  int exp = s21_scale(src);
-  if (strcmp(buffer, DEC_MAX) > 0 && exp > 0) rezult = ERROR;
-  for (unsigned int j = 0; j < strlen(buffer) - exp - 1; j++)
-    buffer[j] = buffer[j + 1];
-  buffer[strlen(buffer) - exp - 1] = '.';
-  int val = strcspn(buffer, ".123456789");
-  char temp[MAXSTR];
-  s21_init(temp);
-  snprintf(temp, strlen(&buffer[val - 1]) + 1, "%s", &buffer[val - 1]);
-  *dst = atof(temp);
-  if (s21_bit(src, 127)) *dst *= -1;
-  if (fabs(*dst) < FLOAT_MIN || isinf(*dst)) rezult = ERROR, *dst = 0.0;
-  return rezult;
+void s21_acc_add(s21_accumulator *acc, s21_decimal value) {
+  s21_big_decimal big;
+  s21_to_big(value, &big);
+  s21_acc_add_big(acc, &big, s21_scale(value), s21_bit(value, 127));
 }
 
 /**
- * @brief Побитовый сдвиг вправо
+ * @brief Точное вычитание числа Decimal из сумматора, без округления
  *
- * @param value указатель на число децимал
- * @param num количество сдвигаемых битов
+ * @param acc указатель на сумматор
+ * @param value вычитаемое
  * @param Владимир
  */
-void s21_shift_bits_right(s21_decimal *value, const int num) {
-  for (int j = 0; j < num; j++) {
-    value->bits[0] >>= 1;
-    if (s21_bit(*value, 31) != s21_bit(*value, 32)) s21_toggle_bit(value, 31);
-    value->bits[1] >>= 1;
-    if (s21_bit(*value, 63) != s21_bit(*value, 64)) s21_toggle_bit(value, 63);
-    value->bits[2] >>= 1;
-    if (s21_bit(*value, 95)) s21_toggle_bit(value, 95);
-  }
+void s21_acc_sub(s21_accumulator *acc, s21_decimal value) {
+  s21_big_decimal big;
+  s21_to_big(value, &big);
+  s21_acc_add_big(acc, &big, s21_scale(value), !s21_bit(value, 127));
 }
 
 /**
- * @brief Побитовый сдвиг влево
+ * @brief Объединение двух сумматоров, например частичных сумм потоков
  *
- * @param value указатель на число децимал
- * @param num количество сдвигаемых битов
+ * @param acc указатель на сумматор, в который добавляется сумма
+ * @param other указатель на добавляемый сумматор
  * @param Владимир
- * @return int код ошибки
  */
-int s21_shift_bits_left(s21_decimal *value, const int num) {
-  int rez = OK;
-  for (int j = 0; j < num; j++) {
-    value->bits[2] <<= 1;
-    if (s21_bit(*value, 63) != s21_bit(*value, 64)) s21_toggle_bit(value, 64);
-    value->bits[1] <<= 1;
-    if (s21_bit(*value, 31) != s21_bit(*value, 32)) s21_toggle_bit(value, 32);
-    value->bits[0] <<= 1;
+void s21_acc_merge(s21_accumulator *acc, const s21_accumulator *other) {
+  for (int scale = 0; scale <= ACC_SCALE; scale++) {
+    if (other->used >> scale & 1u) {
+      s21_big_decimal *bucket = s21_acc_bucket(acc, scale);
+      s21_big_add(bucket, &other->bucket[scale], bucket);
+    }
   }
-  return rez;
 }
 
 /**
- * @brief Подсчет количества битов
+ * @brief Точный итог сумматора: корзины выравниваются по степени ACC_SCALE
+ * и складываются в длинном числе в дополнительном коде, модуль которого
+ * держится меньше 2^382: суммы больше примерно 10^59 считаются переполнением
  *
- * @param value указатель на число децимал
+ * @param acc указатель на сумматор
+ * @param rez модуль итога со степенью ACC_SCALE
+ * @param sign знак итога: 0 - плюс, 1 - минус
  * @param Владимир
- * @return int количество
+ * @return int возвращают код ошибки
  */
-int s21_sum_bits(s21_decimal *value) {
-  int end = 0;
-  for (int i = 96; i >= 0; i--) {
-    if (s21_bit(*value, i) == 1) {
-      end = i + 1;
-      i = -1;
+int s21_acc_total(const s21_accumulator *acc, s21_big_decimal *rez,
+                  int *sign) {
+  int ret = OK;
+  s21_big_decimal zero = {{0}};
+  *rez = zero;
+  for (int i = 0; i <= ACC_SCALE && ret == OK; i++) {
+    if (!(acc->used >> i & 1u)) continue;
+    s21_big_decimal big = acc->bucket[i];
+    int neg = big.bits[BIG_LIMBS - 1] >> 31;
+    if (neg) s21_big_sub(&zero, &big, &big);
+    // 10^n занимает не больше n * 3.33 бита, слагаемое меньше 2^381
+    if (s21_big_bits(&big) + ((ACC_SCALE - i) * 851 >> 8) + 1 > 381) {
+      ret = neg ? NEGATIVE_INF : INF;
+    } else {
+      s21_big_scale_up(&big, ACC_SCALE - i);
+      if (neg)
+        s21_big_sub(rez, &big, rez);
+      else
+        s21_big_add(rez, &big, rez);
+      uint32_t top = rez->bits[BIG_LIMBS - 1] >> 30;
+      if (top == 1 || top == 2) ret = top == 1 ? INF : NEGATIVE_INF;
     }
   }
-  return end;
+  *sign = rez->bits[BIG_LIMBS - 1] >> 31;
+  if (*sign) s21_big_sub(&zero, rez, rez);
+  return ret;
 }
 
 /**
- * @brief Подсчет количества битов
+ * @brief Запись итога сумматора в Decimal с одним бухгалтерским округлением
  *
- * @param dst указатель на число децимал
- * @param src десятичное целое число
- * @param Никита
- * @return int код ошибки
+ * @param big указатель на модуль итога, изменяется
+ * @param scale степень итога
+ * @param sign знак итога
+ * @param ret код ошибки вычисления итога
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки
  */
-int s21_from_int_to_decimal(int src, s21_decimal *dst) {
-  int rez = OK;
-  char buffer[MAXSTR];
-  snprintf(buffer, sizeof(buffer), "%d", src);
-  *dst = dec_null;
-  if (src < 0) {
-    s21_toggle_bit(dst, 127);
-    src *= -1;
-  }
-  unsigned int tmp = *((unsigned int *)&src);
-  if (tmp > MAXINT) {
-    rez = ERROR;
+int s21_acc_result(s21_big_decimal *big, int scale, int sign, int ret,
+                   s21_decimal *result) {
+  if (ret == OK && s21_big_round(big, &scale, ROUND_BANK) != OK)
+    ret = sign ? NEGATIVE_INF : INF;
+  *result = dec_null;
+  if (ret == OK)
+    s21_from_big(big, scale, sign, result);
+  else if (ret == NEGATIVE_INF)
+    result->bits[3] = MINUS;
+  return ret;
+}
+
+/**
+ * @brief Итог сумматора в Decimal с одним бухгалтерским округлением
+ *
+ * @param acc указатель на сумматор
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки
+ */
+int s21_acc_finalize(const s21_accumulator *acc, s21_decimal *result) {
+  s21_big_decimal rez;
+  int sign, ret = s21_acc_total(acc, &rez, &sign);
+  return s21_acc_result(&rez, ACC_SCALE, sign, ret, result);
+}
+
+/**
+ * @brief Среднее значение: точный итог сумматора делится на count один раз
+ * и округляется бухгалтерским способом
+ *
+ * @param acc указатель на сумматор
+ * @param count количество слагаемых
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN при count равном нулю
+ */
+int s21_acc_mean(const s21_accumulator *acc, uint64_t count,
+                 s21_decimal *result) {
+  s21_big_decimal rez = {{0}};
+  int sign = 0, scale = ACC_SCALE, ret = s21_NAN;
+  if (count) {
+    s21_big_decimal div = {{(uint32_t)count, (uint32_t)(count >> 32)}}, rem;
+    ret = s21_acc_total(acc, &rez, &sign);
+    s21_big_divmod(&rez, &div, &rez, &rem);
+    if (ret == OK && !s21_big_is_zero(&rem)) {
+      // ненулевой остаток - единица в разряде ниже отбрасываемых при
+      // округлении, чтобы половина отличалась от чуть большего значения
+      if (s21_big_bits(&rez) > 380) {
+        ret = sign ? NEGATIVE_INF : INF;
+      } else {
+        s21_big_decimal one = {{1}};
+        s21_big_mul_word(&rez, 10);
+        s21_big_add(&rez, &one, &rez);
+        scale++;
+      }
+    }
   }
-  s21_div_decimal_to_two(dst, buffer);
-  return rez;
+  return s21_acc_result(&rez, scale, sign, ret, result);
 }
 
 /**
- * @brief Из децимал в int
+ * @brief Прибавление к сумматору точных произведений a[i] * b[i]
  *
- * @param dst указатель на десятичное целое число
- * @param src число децимал
- * @param Никита
- * @return int код ошибки
+ * @param acc указатель на сумматор
+ * @param a массив первых множителей
+ * @param b массив вторых множителей
+ * @param n количество элементов
+ * @param Владимир
  */
-int s21_from_decimal_to_int(s21_decimal src, int *dst) {
-  int rez = OK;
-  int scale = s21_scale(src);
-  char buffer[MAXSTR] = {0};
-  s21_init(buffer);
-  int sign = 0;
-  if (s21_bit(src, 127) == 0) {
-    sign = 1;
-  } else {
-    sign = -1;
-  }
-  s21_mul_two_to_decimal(src, buffer);
-  *dst = atoi(buffer) * sign;
-  int tmp = *dst;
-  while (scale > 0) {
-    tmp = tmp / 10;
-    scale--;
-  }
-  *dst = tmp;
-  if (src.bits[1] > 0 || src.bits[2] > 0) {
-    *dst = 0;
-    rez = ERROR;
+void s21_acc_dot(s21_accumulator *acc, const s21_decimal *a,
+                 const s21_decimal *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    s21_big_decimal prod;
+    s21_mul_words(a[i], b[i], &prod);
+    s21_acc_add_big(acc, &prod, s21_scale(a[i]) + s21_scale(b[i]),
+                    s21_bit(a[i], 127) ^ s21_bit(b[i], 127));
   }
-  return rez;
 }
 
 /**
- * @brief Умножение двух чисел Decimal
+ * @brief Скалярное произведение массивов Decimal с одним округлением
  *
- * @param value_1 первой множитель
- * @param value_2 второй множитель
- * @param result результат умножения
- * @param Андрей
+ * @param a массив первых множителей
+ * @param b массив вторых множителей
+ * @param n количество элементов
+ * @param result результат
+ * @param Владимир
  * @return int возвращают код ошибки
  */
-int s21_mul(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
-  int flag = OK;
-  char str_1[200] = {0}, str_2[100] = {0}, res[100] = {0};
-  int exp_res = s21_scale(value_1) + s21_scale(value_2);
-  s21_init(str_1);
-  s21_init(str_2);
-  s21_init(res);
-  s21_mul_two_to_decimal(value_1, str_1);
-  s21_mul_two_to_decimal(value_2, str_2);
-  for (int i = strlen(str_2); i > 0; i--) {
-    for (int j = str_2[i - 1] - 48; j > 0; j--) s21_add_str(res, str_1, res);
-    s21_shift_str(str_1);
-  }
-  if (s21_buh_round(res, &exp_res, 0) == 1) {
-    flag = INF;
-  } else {
-    *result = dec_null;
-    s21_div_decimal_to_two(result, res);
-    s21_set_exp(result, exp_res);
-  }
-  if ((s21_bit(value_2, 127) ^ s21_bit(value_1, 127)) == 1) {
-    if (flag == INF)
-      flag = NEGATIVE_INF;
-    else
-      s21_toggle_bit(result, 127);
+int s21_dot(const s21_decimal *a, const s21_decimal *b, size_t n,
+            s21_decimal *result) {
+  s21_accumulator acc;
+  s21_acc_init(&acc);
+  s21_acc_dot(&acc, a, b, n);
+  return s21_acc_finalize(&acc, result);
+}
+
+/**
+ * @brief Трехстороннее сравнение двух чисел Decimal без вычитания: сначала
+ * знаки и нули, затем мантиссы, выровненные по степени в длинном числе
+ * @param value_1 первое число
+ * @param value_2 второе число
+ * @param Владимир
+ * @return int -1 - value_1 меньше, 0 - равны, 1 - value_1 больше value_2
+ */
+int s21_compare(s21_decimal value_1, s21_decimal value_2) {
+  int zero_1 = !(value_1.bits[0] | value_1.bits[1] | value_1.bits[2]);
+  int zero_2 = !(value_2.bits[0] | value_2.bits[1] | value_2.bits[2]);
+  int sign_1 = zero_1 ? 0 : s21_bit(value_1, 127);
+  int sign_2 = zero_2 ? 0 : s21_bit(value_2, 127);
+  int rez = 0;
+  if (sign_1 != sign_2) {
+    rez = sign_1 ? -1 : 1;
+  } else if (!zero_1 || !zero_2) {
+    int scale1 = s21_scale(value_1), scale2 = s21_scale(value_2);
+    if (scale1 == scale2) {
+      for (int i = 2; i >= 0 && !rez; i--)
+        if (value_1.bits[i] != value_2.bits[i])
+          rez = (uint32_t)value_1.bits[i] > (uint32_t)value_2.bits[i] ? 1 : -1;
+    } else {
+      s21_big_decimal big_1, big_2;
+      s21_to_big(value_1, &big_1);
+      s21_to_big(value_2, &big_2);
+      if (scale1 < scale2)
+        s21_big_scale_up(&big_1, scale2 - scale1);
+      else
+        s21_big_scale_up(&big_2, scale1 - scale2);
+      rez = s21_big_cmp(&big_1, &big_2);
+    }
+    if (sign_1) rez = -rez;
   }
-  return flag;
+  return rez;
 }
 
 /**
@@ -630,9 +2190,7 @@ int s21_mul(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
  * @return int 0 - FALSE, 1 - TRUE (value_1 меньше value_2)
  */
 int s21_is_less(s21_decimal value_1, s21_decimal value_2) {
-  s21_decimal res;
-  s21_sub(value_1, value_2, &res);
-  return s21_bit(res, 127);
+  return s21_compare(value_1, value_2) < 0;
 }
 
 /**
@@ -643,7 +2201,7 @@ int s21_is_less(s21_decimal value_1, s21_decimal value_2) {
  * @return int 0 - FALSE, 1 - TRUE (value_1 меньше value_2)
  */
 int s21_is_less_or_equal(s21_decimal value_1, s21_decimal value_2) {
-  return (s21_is_less(value_1, value_2) || s21_is_equal(value_1, value_2));
+  return s21_compare(value_1, value_2) <= 0;
 }
 
 /**
@@ -654,9 +2212,7 @@ int s21_is_less_or_equal(s21_decimal value_1, s21_decimal value_2) {
  * @return int 0 - FALSE, 1 - TRUE (value_1 больше value_2)
  */
 int s21_is_greater(s21_decimal value_1, s21_decimal value_2) {
-  s21_decimal res;
-  s21_sub(value_2, value_1, &res);
-  return s21_bit(res, 127);
+  return s21_compare(value_1, value_2) > 0;
 }
 
 /**
@@ -667,7 +2223,7 @@ int s21_is_greater(s21_decimal value_1, s21_decimal value_2) {
  * @return int 0 - FALSE, 1 - TRUE (value_1 больше или равно value_2)
  */
 int s21_is_greater_or_equal(s21_decimal value_1, s21_decimal value_2) {
-  return (s21_is_greater(value_1, value_2) || s21_is_equal(value_1, value_2));
+  return s21_compare(value_1, value_2) >= 0;
 }
 
 /**
@@ -678,11 +2234,7 @@ int s21_is_greater_or_equal(s21_decimal value_1, s21_decimal value_2) {
  * @return int 0 - FALSE, 1 - TRUE (value_1 равно value_2)
  */
 int s21_is_equal(s21_decimal value_1, s21_decimal value_2) {
-  s21_decimal res;
-  int flag = FALSE;
-  s21_sub(value_2, value_1, &res);
-  if (res.bits[0] == 0 && res.bits[1] == 0 && res.bits[2] == 0) flag = TRUE;
-  return flag;
+  return s21_compare(value_1, value_2) == 0;
 }
 
 /**
@@ -693,9 +2245,7 @@ int s21_is_equal(s21_decimal value_1, s21_decimal value_2) {
  * @return int 0 - FALSE, 1 - TRUE (value_1 не равно value_2)
  */
 int s21_is_not_equal(s21_decimal value_1, s21_decimal value_2) {
-  int flag = FALSE;
-  if (s21_is_equal(value_1, value_2) == 0) flag = TRUE;
-  return flag;
+  return s21_compare(value_1, value_2) != 0;
 }
 
 /**
@@ -724,42 +2274,7 @@ int s21_negate(s21_decimal value, s21_decimal *result) {
  * @return int 0 - OK, 1 - ошибка вычисления
  */
 int s21_round(s21_decimal value, s21_decimal *result) {
-  int flag = OK;
-  if (s21_scale(value) > 28) {
-    flag = ERROR;
-  } else {
-    *result = dec_null;
-    if (s21_scale(value) > 0) {
-      int sign = 0;
-      if (s21_bit(value, 127) == 1) {
-        sign = 1;
-        s21_toggle_bit(&value, 127);
-      }
-      s21_set_exp(&value, s21_scale(value) - 1);
-      s21_truncate(value, result);
-      char res[100] = {0};
-      s21_init(res);
-      s21_mul_two_to_decimal(*result, res);
-      s21_decimal tmp = *result, one = {{1, 0, 0, 0}};
-
-      *result = dec_null;
-      s21_set_exp(&tmp, 1);
-      s21_truncate(tmp, result);
-      char tmp_str[100] = {0};
-      s21_mul_two_to_decimal(*result, tmp_str);
-      if ((strcmp(res, STR_0) != 0) && (sign == 1)) {
-        s21_toggle_bit(result, 127);
-        s21_toggle_bit(&one, 127);
-      }
-      if (res[strlen(res) - 1] >= 53) {
-        tmp = *result;
-        s21_add(tmp, one, result);
-      }
-    } else {
-      *result = value;
-    }
-  }
-  return flag;
+  return s21_rescale(value, 0, ROUND_HALF_UP, result);
 }
 
 /**
@@ -770,25 +2285,7 @@ int s21_round(s21_decimal value, s21_decimal *result) {
  * @return int 0 - OK, 1 - ошибка вычисления
  */
 int s21_truncate(s21_decimal value, s21_decimal *result) {
-  int flag = OK;
-  if (s21_scale(value) > 28) {
-    flag = ERROR;
-  } else {
-    *result = dec_null;
-    if (s21_scale(value) > 0) {
-      int sign = 0;
-      char res[100] = {0};
-      s21_init(res);
-      s21_mul_two_to_decimal(value, res);
-      s21_shift_scale_str(res, -s21_scale(value));
-      if (strcmp(res, STR_0) != 0 && s21_bit(value, 127) == 1) sign = 1;
-      s21_div_decimal_to_two(result, res);
-      if (sign == 1) result->bits[3] = MINUS;
-    } else {
-      *result = value;
-    }
-  }
-  return flag;
+  return s21_rescale(value, 0, ROUND_TRUNC, result);
 }
 
 /**
@@ -800,17 +2297,138 @@ int s21_truncate(s21_decimal value, s21_decimal *result) {
  * @return int 0 - OK, 1 - ошибка вычисления
  */
 int s21_floor(s21_decimal value, s21_decimal *result) {
-  int flag = OK;
-  if (s21_scale(value) > 28) {
+  return s21_rescale(value, 0, ROUND_FLOOR, result);
+}
+
+/**
+ * @brief Приведение числа Decimal к заданной степени: умножение или деление
+ * мантиссы на одно значение из таблицы степеней 10 с указанным округлением
+ * @param value число Decimal
+ * @param new_scale новая степень от 0 до 28
+ * @param rounding способ округления: ROUND_BANK, ROUND_TRUNC, ROUND_HALF_UP,
+ * ROUND_FLOOR, ROUND_CEIL
+ * @param result результат, степень равна new_scale, ноль без знака
+ * @param Владимир
+ * @return int 0 - OK, 1 - ошибка вычисления или мантисса не помещается в 96
+ * бит
+ */
+int s21_rescale(s21_decimal value, int new_scale, int rounding,
+                s21_decimal *result) {
+  int flag = OK, scale = s21_scale(value), sign = s21_bit(value, 127);
+  if (scale < 0 || scale > MAXEXP || new_scale < 0 || new_scale > MAXEXP ||
+      rounding < ROUND_BANK || rounding > ROUND_CEIL) {
+    flag = ERROR;
+  } else {
+    s21_big_decimal big;
+    s21_to_big(value, &big);
+    if (new_scale > scale) s21_big_scale_up(&big, new_scale - scale);
+    if (new_scale < scale) {
+      // для модуля отрицательного числа floor и ceil меняются местами
+      if (sign && rounding == ROUND_FLOOR)
+        rounding = ROUND_CEIL;
+      else if (sign && rounding == ROUND_CEIL)
+        rounding = ROUND_FLOOR;
+      s21_big_scale_down(&big, scale - new_scale, rounding);
+    }
+    if (!s21_big_fits(&big)) {
+      flag = ERROR;
+    } else {
+      for (int i = 0; i < 3; i++) result->bits[i] = (int)big.bits[i];
+      result->bits[3] = new_scale << 16;
+      if (sign && !s21_big_is_zero(&big)) result->bits[3] |= MINUS;
+    }
+  }
+  return flag;
+}
+
+/**
+ * @brief Каноническая запись числа: хвостовые нули мантиссы отбрасываются,
+ * ноль записывается без знака и степени. 10^k может делить мантиссу, только
+ * если ее младшие k битов нулевые, остальное проверяется делением на
+ * степени 10 из таблицы по убыванию, как двоичный поиск наибольшего k
+ * @param value число Decimal
+ * @param result результат
+ * @param Владимир
+ * @return int 0 - OK, 1 - ошибка степени
+ */
+int s21_normalize(s21_decimal value, s21_decimal *result) {
+  int flag = OK, scale = s21_scale(value), sign = s21_bit(value, 127);
+  uint32_t lo = (uint32_t)value.bits[0], mid = (uint32_t)value.bits[1],
+           hi = (uint32_t)value.bits[2];
+  if (scale > MAXEXP) {
     flag = ERROR;
+  } else if (!(lo | mid | hi)) {
+    *result = dec_null;
   } else {
-    s21_decimal tmp = {{1, 0, 0, 0}};
-    s21_truncate(value, result);
-    if (s21_bit(value, 127) == 1) s21_sub(*result, tmp, result);
+    int zeros = lo    ? __builtin_ctz(lo)
+                : mid ? 32 + __builtin_ctz(mid)
+                      : 64 + __builtin_ctz(hi);
+    int limit = zeros < scale ? zeros : scale;
+    if (!hi) {
+      uint64_t mant = lo | (uint64_t)mid << 32;
+      for (int step = 16; step; step >>= 1)
+        if (step <= limit && mant % pow10_u64[step] == 0)
+          mant /= pow10_u64[step], limit -= step, scale -= step;
+      s21_from_u64(mant, scale, sign, result);
+    } else {
+      s21_big_decimal big, temp;
+      s21_to_big(value, &big);
+      int step = 9;
+      while (step) {
+        temp = big;
+        if (step <= limit && !s21_big_div_pow10(&temp, step)) {
+          big = temp, limit -= step, scale -= step;
+        } else {
+          // 10^9 больше не делит: остаток меньше 9 ищется шагами 8, 4, 2, 1
+          step = step == 9 ? 8 : step >> 1;
+        }
+      }
+      s21_from_big(&big, scale, sign, result);
+    }
   }
   return flag;
 }
 
+/**
+ * @brief Перемешивание битов 64-битного слова (финализатор MurmurHash3)
+ * @param x слово
+ * @param Владимир
+ * @return uint64_t перемешанное слово
+ */
+uint64_t s21_mix64(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+/**
+ * @brief 64-битный хеш канонической записи числа: равные числа, например
+ * 1.5 и 1.50 или -0 и +0, имеют одинаковый хеш
+ * @param value число Decimal
+ * @param Владимир
+ * @return uint64_t хеш
+ */
+uint64_t s21_hash(s21_decimal value) {
+  s21_decimal key = value;
+  s21_normalize(value, &key);
+  return s21_hash_canon(key);
+}
+
+/**
+ * @brief Хеш числа, уже записанного в каноническом виде s21_normalize
+ * @param key каноническое число
+ * @param Владимир
+ * @return uint64_t хеш
+ */
+uint64_t s21_hash_canon(s21_decimal key) {
+  uint64_t lo = (uint32_t)key.bits[0] | (uint64_t)(uint32_t)key.bits[1] << 32;
+  uint64_t hi = (uint32_t)key.bits[2] | (uint64_t)(uint32_t)key.bits[3] << 32;
+  return s21_mix64(lo ^ s21_mix64(hi + HASH_SEED));
+}
+
 /**
  * @brief умножение числа на 10
  * @param str указатель на строку, в которой сохранено число
@@ -841,117 +2459,76 @@ int s21_set_exp(s21_decimal *value, int exp) {
   return flag;
 }
 
+/**
+ * @brief Деление двух чисел Decimal: делимое домножается на 10^n так, чтобы
+ * частное имело не меньше 30 значащих цифр, лишние цифры частного
+ * отбрасываются
+ *
+ * @param value_1 делимое
+ * @param value_2 делитель
+ * @param result результат деления
+ * @param Владимир
+ * @return int возвращают код ошибки
+ */
 int s21_div(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
-  s21_decimal ten = dec_null;
-  ten.bits[0] = 10;
   int rez = OK;
   if (s21_test_zero(&value_2)) {
     rez = s21_NAN;
   } else {
-    int sign_v1 = s21_bit(value_1, 127), sign_v2 = s21_bit(value_2, 127);
-    int sign_res = sign_v1 == sign_v2 ? 0 : 1;
-    if (sign_v1 == 1) s21_toggle_bit(&value_1, 127);
-    if (sign_v2 == 1) s21_toggle_bit(&value_2, 127);
-    s21_decimal dec_one = dec_null, tmp = dec_null;
-    *result = dec_null;
-    dec_one.bits[0] = 1;
-    int flag_mul = 0, exp_1 = s21_scale(value_1), exp_2 = s21_scale(value_2);
-    if (s21_is_greater_or_equal(value_1, value_2) == TRUE)
-      s21_toggle_bit(&tmp, 0);
-    while (s21_is_less(value_2, dec_one)) {
-      if (exp_1 >= exp_2) {
-        exp_1 = exp_1 - exp_2;
-        s21_set_exp(&value_1, exp_1);
-      } else {
-        int count_mul = exp_2 - exp_1;
-        while (count_mul > 0) {
-          flag_mul = s21_mul(value_1, ten, &value_1);
-          if (flag_mul != 0) break;
-          count_mul--;
-        }
-        s21_set_exp(&value_1, 0);
-      }
-      s21_set_exp(&value_2, 0);
-    }
-    while (s21_is_less(value_1, value_2)) {
-      int tmp1 = exp_1;
-      s21_set_exp(&value_1, 0);
-      flag_mul = s21_mul(value_1, ten, &value_1);
-      if (flag_mul != 0 || s21_is_equal(value_1, dec_null)) break;
-      s21_set_exp(&value_1, tmp1);
-    }
-    s21_decimal tmp_value_1 = value_1;
-    int exp_res = s21_scale(value_1) + s21_scale(value_2);
-    if (s21_is_less_or_equal(value_2, value_1) == TRUE) {
-      while (1) {
-        int bits_value_1 = s21_sum_bits(&value_1);
-        int bits_value_2 = s21_sum_bits(&value_2);
-        s21_decimal tmp_value_2 = value_2;
-        while (bits_value_1 > bits_value_2) {
-          s21_shift_bits_left(&tmp_value_2, 1);
-          s21_shift_bits_left(&tmp, 1);
-          bits_value_2++;
-          if (bits_value_1 == bits_value_2) {
-            if (s21_is_greater_or_equal(value_1, tmp_value_2)) {
-              break;
-            } else {
-              s21_shift_bits_right(&tmp_value_2, 1);
-              s21_shift_bits_right(&tmp, 1);
-            }
-          }
-        }
-        s21_sub(value_1, tmp_value_2, &value_1);
-        s21_add(*result, tmp, result);
-        tmp = dec_null;
-        s21_toggle_bit(&tmp, 0);
-        if (s21_is_less(value_1, value_2)) {
-          if (s21_test_zero(&value_1)) {
-            break;
-          } else {
-            int res_mul = s21_mul(tmp_value_1, ten, &tmp_value_1);
-            if (res_mul == 1) break;
-            value_1 = tmp_value_1;
-            exp_res++;
-            *result = dec_null;
-          }
-        }
-      }
-      s21_set_exp(result, exp_res);
-      if (sign_res == 1) {
-        if (flag_mul == INF) flag_mul = NEGATIVE_INF;
-        s21_toggle_bit(result, 127);
-      }
-    }
-    rez = flag_mul;
+    int sign = s21_bit(value_1, 127) ^ s21_bit(value_2, 127);
+    int scale = s21_scale(value_1) - s21_scale(value_2);
+    s21_big_decimal big_1, big_2, quot, rem;
+    s21_to_big(value_1, &big_1);
+    s21_to_big(value_2, &big_2);
+    // 78/256 чуть больше log10(2): частное не меньше 2^99
+    int num = ((s21_big_bits(&big_2) + 99 - s21_big_bits(&big_1)) * 78 + 255) >>
+              8;
+    if (num > MAXEXP + 1 - scale) num = MAXEXP + 1 - scale;
+    if (num < -scale) num = -scale;
+    if (num < 0) num = 0;
+    s21_big_scale_up(&big_1, num);
+    scale += num;
+    s21_big_divmod(&big_1, &big_2, &quot, &rem);
+    rez = s21_big_round(&quot, &scale, ROUND_TRUNC);
+    if (rez == OK)
+      s21_from_big(&quot, scale, sign, result);
+    else if (sign)
+      rez = NEGATIVE_INF;
   }
   return rez;
 }
 
+/**
+ * @brief Остаток от деления модулей двух чисел Decimal, берется из того же
+ * деления столбиком после выравнивания степеней. Как и раньше, дробный
+ * остаток отбрасывается, а при переполнении частного возвращается ошибка
+ *
+ * @param value_1 делимое
+ * @param value_2 делитель
+ * @param result остаток от деления
+ * @param Владимир
+ * @return int возвращают код ошибки
+ */
 int s21_mod(s21_decimal value_1, s21_decimal value_2, s21_decimal *result) {
-  int rez = OK, flag = 0, sign_value1 = 0;
-  s21_decimal integer_dec = dec_null, mul_intdec_val2 = dec_null,
-              mod_dec = dec_null;
-  if (s21_bit(value_1, 127) == 1) {
-    sign_value1 = 1;
-    s21_toggle_bit(&value_1, 127);
-  }
-  if (s21_bit(value_2, 127) == 1) {
-    s21_toggle_bit(&value_2, 127);
-  }
-  flag = s21_div(value_1, value_2, result);
-  if (flag != 0) {
-    rez = flag;
-  }
-  s21_truncate(*result, &integer_dec);
-  s21_mul(integer_dec, value_2, &mul_intdec_val2);
-  s21_sub(value_1, mul_intdec_val2, &mod_dec);
-  if (flag == INF && sign_value1 == 1) {
-    flag = NEGATIVE_INF;
-    rez = flag;
-  }
-  *result = mod_dec;
-  if (s21_scale(*result) != 0) {
+  int rez = OK;
+  if (s21_test_zero(&value_2)) {
+    rez = s21_NAN;
+  } else {
+    int scale1 = s21_scale(value_1), scale2 = s21_scale(value_2);
+    int scale = scale1 > scale2 ? scale1 : scale2;
+    s21_big_decimal big_1, big_2, quot, rem;
+    s21_to_big(value_1, &big_1);
+    s21_to_big(value_2, &big_2);
+    s21_big_scale_up(&big_1, scale - scale1);
+    s21_big_scale_up(&big_2, scale - scale2);
+    s21_big_divmod(&big_1, &big_2, &quot, &rem);
     *result = dec_null;
+    if (!s21_big_fits(&quot)) {
+      rez = s21_bit(value_1, 127) ? NEGATIVE_INF : INF;
+    } else {
+      s21_big_round(&rem, &scale, ROUND_TRUNC);
+      if (scale == 0) s21_from_big(&rem, 0, 0, result);
+    }
   }
   return rez;
 }
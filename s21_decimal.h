@@ -1,6 +1,9 @@
 #ifndef SRC_S21_DECIMAL_H_
 #define SRC_S21_DECIMAL_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #define FLOAT_MIN 1e-28
 #define FLOAT_ROUND 7
 #define DEC_MAX "79228162514264337593543950335"
@@ -20,11 +23,162 @@ typedef struct {
   int bits[4];
 } s21_decimal;
 
+// операция над двумя числами Decimal, как s21_add
+typedef int (*s21_decimal_op)(s21_decimal, s21_decimal, s21_decimal *);
+
+// пул потоков для параллельных сверток, потоки есть только в сборке с
+// S21_THREADS, иначе задачи выполняются в вызывающем потоке
+typedef struct s21_pool s21_pool;
+// задача пула: part - номер куска, worker - номер исполнителя
+typedef void (*s21_task)(void *arg, size_t part, int worker);
+// кусок массива, который получает один исполнитель
+#define PAR_CHUNK ((size_t)1 << 16)
+
+// начальное значение хеша, дробная часть золотого сечения
+#define HASH_SEED 0x9e3779b97f4a7c15ULL
+
+// длинное число для промежуточных вычислений: мантисса без знака и степени
+#define BIG_LIMBS 12
+typedef struct {
+  uint32_t bits[BIG_LIMBS];
+} s21_big_decimal;
+
+// таблицы степеней 10
+extern const uint64_t pow10_u64[20];
+extern const uint32_t pow10_bits[MAXEXP + 1][3];
+extern const uint32_t pow10_recip[10][3];
+extern const double pow10_dbl[23];
+// пары цифр 00..99 для записи числа по две цифры
+extern const char digit_pairs[201];
+
+// точный сумматор: отдельная сумма в дополнительном коде для каждой
+// степени до ACC_SCALE, 56 знаков вмещают точные произведения двух Decimal
+#define ACC_SCALE (2 * MAXEXP)
+typedef struct {
+  s21_big_decimal bucket[ACC_SCALE + 1];
+  uint64_t used;  // маска корзин, в которые что-то добавлено
+} s21_accumulator;
+
+// колонка чисел Decimal: слова мантиссы и байт знака со степенью хранятся
+// в отдельных массивах, выровненных по COLUMN_ALIGN байт
+#define COLUMN_ALIGN 64
+// степень в байте знака: младшие 5 бит, знак - старший бит
+#define COLUMN_SCALE 0x1f
+// частичные 128-битные суммы мантисс вмещают 2^30 слагаемых до 2^96
+#define WIDE_BLOCK ((size_t)1 << 30)
+// кусок колонки, который суммируется по словам мантисс
+#define COLUMN_CHUNK 4096
+typedef struct {
+  uint32_t *lo, *mid, *hi;
+  uint8_t *meta;
+  size_t size, capacity;
+  int owner;  // FALSE у среза, который ссылается на чужую память
+} s21_decimal_column;
+
+// ключ поразрядной сортировки: 192-битное значение с порядком как у чисел и
+// номер исходного элемента
+#define SORT_DIGITS 24
+typedef struct {
+  uint64_t key[3];
+  size_t index;
+} s21_sort_item;
+
+// результат разбора текста: конец разобранного числа и код ошибки
+typedef struct {
+  const char *ptr;
+  int error;
+} s21_from_chars_result;
+// результат записи текста: конец записанного числа и код ошибки
+typedef struct {
+  char *ptr;
+  int error;
+} s21_to_chars_result;
+// точность s21_to_chars_fixed для кратчайшей точной записи
+#define CHARS_SHORTEST -1
+// настройки пакетной записи: separator пишется между числами (NULL - без
+// разделителя), precision как в s21_to_chars_fixed
+typedef struct {
+  const char *separator;
+  int precision;
+} s21_format_options;
+// одно число занимает не больше FORMAT_CHARS символов и precision знаков
+// дроби: знак, MAXDEC цифр и точка
+#define FORMAT_CHARS (MAXDEC + 2)
+// аргументы пакетной записи: числа из массива src или колонки col
+typedef struct {
+  const s21_decimal *src;
+  const s21_decimal_column *col;
+  size_t n;
+  const char *separator;
+  size_t separator_len;
+  int precision;
+  char *first, *last;  // буфер параллельной записи
+  size_t stride;       // место под число с разделителем
+  size_t *len;         // длины записи кусков, SIZE_MAX - ошибка
+} s21_format_job;
+// разбор хранит первые PARSE_DIGITS значащих цифр, остальные дают только
+// признак ненулевого хвоста для округления
+#define PARSE_DIGITS 38
+// предел показателя экспоненты, дальше он насыщается
+#define PARSE_EXP 100000
+typedef struct {
+  s21_big_decimal big;  // перенесенные значащие цифры
+  uint64_t chunk;       // до 18 цифр, еще не перенесенных в big
+  int len, digits;      // цифр в chunk и всего значащих цифр
+  int exp, sticky, any;
+} s21_parse_state;
+
+// хеш-таблица с открытой адресацией: ключи хранятся в каноническом виде,
+// hash == 0 означает пустую ячейку, емкость - степень двойки
+#define MAP_MIN 16
+typedef struct {
+  uint64_t hash;
+  s21_decimal key;
+  size_t value;
+} s21_map_slot;
+typedef struct {
+  s21_map_slot *slot;
+  size_t size, capacity;
+} s21_decimal_map;
+
+// группа агрегации: точная сумма в дополнительном коде со степенью scale,
+// наименьшее и наибольшее значения и номер первой строки группы
+typedef struct {
+  s21_decimal key;  // канонический ключ
+  s21_decimal min, max;
+  s21_big_decimal sum;
+  int scale;
+  uint64_t count;
+  size_t first;
+} s21_group;
+// таблица групп в порядке первого появления ключа, rows - количество уже
+// обработанных строк
+typedef struct {
+  s21_decimal_map map;  // ключ -> номер группы
+  s21_group *group;
+  size_t size, capacity, rows;
+} s21_group_table;
+// количество разделов параллельной группировки
+#define GROUP_BITS 6
+
 int s21_add(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
 int s21_sub(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
 int s21_mul(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
 int s21_div(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
 int s21_mod(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
+int s21_fma(s21_decimal value_1, s21_decimal value_2, s21_decimal value_3,
+            s21_decimal *result);
+int s21_dot(const s21_decimal *a, const s21_decimal *b, size_t n,
+            s21_decimal *result);
+void s21_acc_init(s21_accumulator *acc);
+void s21_acc_add(s21_accumulator *acc, s21_decimal value);
+void s21_acc_sub(s21_accumulator *acc, s21_decimal value);
+void s21_acc_dot(s21_accumulator *acc, const s21_decimal *a,
+                 const s21_decimal *b, size_t n);
+void s21_acc_merge(s21_accumulator *acc, const s21_accumulator *other);
+int s21_acc_finalize(const s21_accumulator *acc, s21_decimal *result);
+int s21_acc_mean(const s21_accumulator *acc, uint64_t count,
+                 s21_decimal *result);
 // 0 - OK
 #define OK 0
 // 1 - число слишком велико или равно бесконечности
@@ -33,6 +187,25 @@ int s21_mod(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
 #define NEGATIVE_INF 2
 // 3 - деление на 0
 #define s21_NAN 3
+// способы округления
+// 0 - бухгалтерское округление
+#define ROUND_BANK 0
+// 1 - отбрасывание лишних цифр
+#define ROUND_TRUNC 1
+// 2 - математическое округление, половина от нуля
+#define ROUND_HALF_UP 2
+// 3 - в сторону отрицательной бесконечности
+#define ROUND_FLOOR 3
+// 4 - в сторону положительной бесконечности
+#define ROUND_CEIL 4
+
+// счетчики быстрого пути s21_add, s21_sub и s21_mul для мантисс до 64 бит
+typedef struct {
+  unsigned long long fast;  // выполнено на 64-битных словах
+  unsigned long long slow;  // выполнено через длинные числа
+} s21_fast_stats;
+void s21_get_fast_stats(s21_fast_stats *stats);
+void s21_reset_fast_stats(void);
 
 int s21_is_less(s21_decimal, s21_decimal);
 int s21_is_less_or_equal(s21_decimal, s21_decimal);
@@ -40,15 +213,31 @@ int s21_is_greater(s21_decimal, s21_decimal);
 int s21_is_greater_or_equal(s21_decimal, s21_decimal);
 int s21_is_equal(s21_decimal, s21_decimal);
 int s21_is_not_equal(s21_decimal, s21_decimal);
+int s21_compare(s21_decimal, s21_decimal);
 // 1 - TRUE
 #define TRUE 1
 // 0 - FALSE
 #define FALSE 0
+// s21_compare: -1 - меньше, 0 - равно, 1 - больше
 
 int s21_from_int_to_decimal(int src, s21_decimal *dst);
 int s21_from_float_to_decimal(float src, s21_decimal *dst);
 int s21_from_decimal_to_int(s21_decimal src, int *dst);
 int s21_from_decimal_to_float(s21_decimal src, float *dst);
+int s21_from_decimal_to_double(s21_decimal src, double *dst);
+int s21_from_int64_to_decimal(int64_t src, s21_decimal *dst);
+int s21_from_uint64_to_decimal(uint64_t src, s21_decimal *dst);
+int s21_from_decimal_to_int64(s21_decimal src, int64_t *dst);
+int s21_from_decimal_to_uint64(s21_decimal src, uint64_t *dst);
+s21_from_chars_result s21_from_chars(const char *first, const char *last,
+                                     s21_decimal *out);
+s21_to_chars_result s21_to_chars(char *first, char *last, s21_decimal value);
+s21_to_chars_result s21_to_chars_fixed(char *first, char *last,
+                                       s21_decimal value, int precision);
+#ifdef __SIZEOF_INT128__
+int s21_from_uint128_to_decimal(unsigned __int128 src, s21_decimal *dst);
+int s21_from_decimal_to_uint128(s21_decimal src, unsigned __int128 *dst);
+#endif
 // 0 - OK
 
 // 1 - ошибка конвертации
@@ -58,9 +247,154 @@ int s21_floor(s21_decimal value, s21_decimal *result);
 int s21_round(s21_decimal value, s21_decimal *result);
 int s21_truncate(s21_decimal value, s21_decimal *result);
 int s21_negate(s21_decimal value, s21_decimal *result);
+int s21_rescale(s21_decimal value, int new_scale, int rounding,
+                s21_decimal *result);
+int s21_normalize(s21_decimal value, s21_decimal *result);
+uint64_t s21_hash(s21_decimal value);
 //  0 - OK
 //  1 - ошибка вычисления
 
+int s21_column_init(s21_decimal_column *col, size_t capacity);
+void s21_column_free(s21_decimal_column *col);
+int s21_column_reserve(s21_decimal_column *col, size_t capacity);
+int s21_column_append(s21_decimal_column *col, s21_decimal value);
+int s21_column_get(const s21_decimal_column *col, size_t i,
+                   s21_decimal *value);
+int s21_column_set(s21_decimal_column *col, size_t i, s21_decimal value);
+int s21_column_slice(const s21_decimal_column *col, size_t begin, size_t end,
+                     s21_decimal_column *view);
+int s21_column_from_array(s21_decimal_column *col, const s21_decimal *src,
+                          size_t n);
+void s21_column_to_array(const s21_decimal_column *col, s21_decimal *dst);
+int s21_column_add(const s21_decimal_column *a, const s21_decimal_column *b,
+                   s21_decimal_column *out, int *status);
+int s21_column_sub(const s21_decimal_column *a, const s21_decimal_column *b,
+                   s21_decimal_column *out, int *status);
+// уровни векторных ядер, выбираются по cpuid
+#define SIMD_SCALAR 0
+#define SIMD_AVX2 1
+#define SIMD_AVX512 2
+int s21_simd_level(void);
+void s21_simd_limit(int level);
+
+// поэлементные операции над массивами, status может быть NULL,
+// возвращается код первого неудачного элемента
+int s21_add_n(const s21_decimal *a, const s21_decimal *b, s21_decimal *out,
+              int *status, size_t n);
+int s21_sub_n(const s21_decimal *a, const s21_decimal *b, s21_decimal *out,
+              int *status, size_t n);
+int s21_mul_n(const s21_decimal *a, const s21_decimal *b, s21_decimal *out,
+              int *status, size_t n);
+int s21_div_n(const s21_decimal *a, const s21_decimal *b, s21_decimal *out,
+              int *status, size_t n);
+int s21_mod_n(const s21_decimal *a, const s21_decimal *b, s21_decimal *out,
+              int *status, size_t n);
+int s21_add_scalar_n(const s21_decimal *a, s21_decimal b, s21_decimal *out,
+                     int *status, size_t n);
+int s21_sub_scalar_n(const s21_decimal *a, s21_decimal b, s21_decimal *out,
+                     int *status, size_t n);
+int s21_mul_scalar_n(const s21_decimal *a, s21_decimal b, s21_decimal *out,
+                     int *status, size_t n);
+int s21_div_scalar_n(const s21_decimal *a, s21_decimal b, s21_decimal *out,
+                     int *status, size_t n);
+int s21_mod_scalar_n(const s21_decimal *a, s21_decimal b, s21_decimal *out,
+                     int *status, size_t n);
+//  0 - OK
+//  1 - ошибка памяти или аргументов
+
+// агрегаты значимых элементов: valid - битовая маска (бит i % 8 байта
+// i / 8) или NULL, сумма и среднее округляются один раз
+int s21_sum(const s21_decimal *src, const uint8_t *valid, size_t n,
+            s21_decimal *result);
+int s21_mean(const s21_decimal *src, const uint8_t *valid, size_t n,
+             s21_decimal *result);
+int s21_min(const s21_decimal *src, const uint8_t *valid, size_t n,
+            s21_decimal *result);
+int s21_max(const s21_decimal *src, const uint8_t *valid, size_t n,
+            s21_decimal *result);
+size_t s21_count(const uint8_t *valid, size_t n);
+int s21_column_sum(const s21_decimal_column *col, const uint8_t *valid,
+                   s21_decimal *result);
+int s21_column_mean(const s21_decimal_column *col, const uint8_t *valid,
+                    s21_decimal *result);
+int s21_column_min(const s21_decimal_column *col, const uint8_t *valid,
+                   s21_decimal *result);
+int s21_column_max(const s21_decimal_column *col, const uint8_t *valid,
+                   s21_decimal *result);
+//  0 - OK
+//  1 - INF
+//  2 - NEGATIVE_INF
+//  3 - нет значимых элементов
+
+s21_pool *s21_pool_create(int threads);
+void s21_pool_free(s21_pool *pool);
+int s21_pool_threads(const s21_pool *pool);
+int s21_par_sum(s21_pool *pool, const s21_decimal *src, const uint8_t *valid,
+                size_t n, s21_decimal *result);
+int s21_par_dot(s21_pool *pool, const s21_decimal *a, const s21_decimal *b,
+                size_t n, s21_decimal *result);
+int s21_par_min(s21_pool *pool, const s21_decimal *src, const uint8_t *valid,
+                size_t n, s21_decimal *result);
+int s21_par_max(s21_pool *pool, const s21_decimal *src, const uint8_t *valid,
+                size_t n, s21_decimal *result);
+//  результат не зависит от количества потоков
+
+// устойчивая сортировка по возрастанию, -0 и +0, 1.0 и 1.00 равны
+int s21_sort(s21_decimal *src, size_t n);
+int s21_sort_index(const s21_decimal *src, size_t n, size_t *perm);
+int s21_column_sort_index(const s21_decimal_column *col, size_t *perm);
+//  0 - OK
+//  1 - ошибка памяти
+
+// ключи сравниваются по значению: 1.5 и 1.50, -0 и +0 - один ключ
+int s21_map_init(s21_decimal_map *map, size_t capacity);
+void s21_map_free(s21_decimal_map *map);
+int s21_map_insert(s21_decimal_map *map, s21_decimal key, size_t value,
+                   size_t *stored);
+int s21_map_put(s21_decimal_map *map, s21_decimal key, size_t value);
+//  0 - OK
+//  1 - ошибка памяти или степень больше 28
+int s21_map_get(const s21_decimal_map *map, s21_decimal key, size_t *value);
+int s21_map_remove(s21_decimal_map *map, s21_decimal key);
+//  0 - FALSE, ключа нет
+//  1 - TRUE
+
+// строки с незначимым значением пропускаются, группы копятся между вызовами
+int s21_group_init(s21_group_table *table, size_t capacity);
+void s21_group_free(s21_group_table *table);
+int s21_group_by(s21_group_table *table, const s21_decimal *keys,
+                 const s21_decimal *values, const uint8_t *valid, size_t n);
+int s21_column_group_by(s21_group_table *table,
+                        const s21_decimal_column *keys,
+                        const s21_decimal_column *values,
+                        const uint8_t *valid);
+int s21_par_group_by(s21_pool *pool, s21_group_table *table,
+                     const s21_decimal *keys, const s21_decimal *values,
+                     const uint8_t *valid, size_t n);
+//  0 - OK
+//  1 - ошибка памяти, степени или размеров колонок
+int s21_group_sum(const s21_group *group, s21_decimal *result);
+//  0 - OK
+//  1 - INF
+//  2 - NEGATIVE_INF
+
+// числа записываются подряд через разделитель, как s21_to_chars_fixed
+size_t s21_format_bound(size_t n, const s21_format_options *opt);
+s21_to_chars_result s21_format(char *first, char *last, const s21_decimal *src,
+                               size_t n, const s21_format_options *opt);
+s21_to_chars_result s21_column_format(char *first, char *last,
+                                      const s21_decimal_column *col,
+                                      const s21_format_options *opt);
+s21_to_chars_result s21_par_format(s21_pool *pool, char *first, char *last,
+                                   const s21_decimal *src, size_t n,
+                                   const s21_format_options *opt);
+s21_to_chars_result s21_par_column_format(s21_pool *pool, char *first,
+                                          char *last,
+                                          const s21_decimal_column *col,
+                                          const s21_format_options *opt);
+//  0 - OK
+//  1 - ERROR, буфер мал или степень числа больше 28
+
 // Доп функции
 
 int s21_shift_bits_left(s21_decimal *value, const int num);
@@ -83,5 +417,129 @@ int s21_test_zero(s21_decimal *val);
 int s21_sum_bits(s21_decimal *value);
 int s21_set_exp(s21_decimal *value, int num);
 void s21_shift_str(char *str);
+void s21_to_big(const s21_decimal value, s21_big_decimal *big);
+void s21_from_big(const s21_big_decimal *big, int scale, int sign,
+                  s21_decimal *dst);
+int s21_big_fits(const s21_big_decimal *big);
+int s21_big_is_zero(const s21_big_decimal *big);
+int s21_big_bits(const s21_big_decimal *big);
+int s21_big_cmp(const s21_big_decimal *big_1, const s21_big_decimal *big_2);
+void s21_big_add(const s21_big_decimal *big_1, const s21_big_decimal *big_2,
+                 s21_big_decimal *rez);
+void s21_big_sub(const s21_big_decimal *big_1, const s21_big_decimal *big_2,
+                 s21_big_decimal *rez);
+void s21_mul_words(const s21_decimal value_1, const s21_decimal value_2,
+                   s21_big_decimal *rez);
+uint32_t s21_big_mul_word(s21_big_decimal *big, const uint32_t num);
+uint32_t s21_big_div_word(s21_big_decimal *big, const uint32_t num);
+uint32_t s21_big_div_pow10(s21_big_decimal *big, const int num);
+void s21_big_divmod(const s21_big_decimal *big_1, const s21_big_decimal *big_2,
+                    s21_big_decimal *quot, s21_big_decimal *rem);
+void s21_big_mul(const s21_big_decimal *big_1, const s21_big_decimal *big_2,
+                 s21_big_decimal *rez);
+void s21_big_pow10(const int num, s21_big_decimal *big);
+void s21_big_scale_up(s21_big_decimal *big, int num);
+void s21_big_scale_down(s21_big_decimal *big, int num, int flag);
+void s21_big_shift_left(s21_big_decimal *big, int num);
+void s21_big_shift_right(s21_big_decimal *big, int num, int flag);
+int s21_big_fit(s21_big_decimal *big, int *scale, int flag);
+int s21_big_round(s21_big_decimal *big, int *scale, int flag);
+int s21_add_big(s21_decimal value_1, s21_decimal value_2, int sign2,
+                s21_decimal *result);
+int s21_big_sum(s21_big_decimal *big_1, int scale1, int sign1,
+                s21_big_decimal *big_2, int scale2, int sign2,
+                s21_decimal *result);
+s21_big_decimal *s21_acc_bucket(s21_accumulator *acc, int scale);
+void *s21_column_alloc(size_t size);
+uint8_t s21_column_pack(s21_decimal value);
+int s21_batch(s21_decimal_op op, const s21_decimal *a, const s21_decimal *b,
+              size_t step, s21_decimal *out, int *status, size_t n);
+int s21_column_lane(const s21_decimal_column *a, const s21_decimal_column *b,
+                    s21_decimal_column *out, size_t i, int sub);
+int s21_column_op(const s21_decimal_column *a, const s21_decimal_column *b,
+                  s21_decimal_column *out, int *status, int sub);
+int s21_valid(const uint8_t *valid, size_t i);
+void s21_wide_add(uint64_t *sum, uint64_t lo, uint32_t hi, int sign);
+void s21_wide_flush(s21_accumulator *acc, uint64_t (*sums)[2],
+                    uint32_t used);
+void s21_acc_array(s21_accumulator *acc, const s21_decimal *src,
+                   const uint8_t *valid, size_t n);
+void s21_acc_chunk(s21_accumulator *acc, const s21_decimal_column *col,
+                   size_t begin, size_t end);
+void s21_acc_column(s21_accumulator *acc, const s21_decimal_column *col,
+                    const uint8_t *valid);
+void s21_extreme_slot(uint64_t (*key)[2], size_t *pos, int slot, uint64_t lo,
+                      uint64_t hi, size_t i);
+int s21_extreme(const s21_decimal *src, const uint8_t *valid, size_t n,
+                int dir, s21_decimal *result);
+int s21_column_extreme(const s21_decimal_column *col, const uint8_t *valid,
+                       int dir, s21_decimal *result);
+void s21_pool_drain(s21_pool *pool, int worker);
+void *s21_pool_worker(void *data);
+void s21_pool_run(s21_pool *pool, s21_task task, void *arg, size_t parts);
+void s21_par_sum_task(void *arg, size_t part, int worker);
+void s21_par_dot_task(void *arg, size_t part, int worker);
+void s21_par_extreme_task(void *arg, size_t part, int worker);
+int s21_par_extreme(s21_pool *pool, const s21_decimal *src,
+                    const uint8_t *valid, size_t n, int dir,
+                    s21_decimal *result);
+void s21_sort_key(uint32_t lo, uint32_t mid, uint32_t hi, uint8_t meta,
+                  int top, uint64_t *key);
+int s21_radix_sort(s21_sort_item *item, size_t n);
+void s21_acc_add_big(s21_accumulator *acc, s21_big_decimal *big, int scale,
+                     int sign);
+int s21_acc_total(const s21_accumulator *acc, s21_big_decimal *rez,
+                  int *sign);
+int s21_acc_result(s21_big_decimal *big, int scale, int sign, int ret,
+                   s21_decimal *result);
+void s21_from_u64(uint64_t val, int scale, int sign, s21_decimal *dst);
+int s21_add_u64(s21_decimal value_1, s21_decimal value_2, int sign2,
+                s21_decimal *result);
+int s21_mul_u64(s21_decimal value_1, s21_decimal value_2, s21_decimal *result);
+void s21_float_digits(uint32_t mantisa, int exp, int scale, int flag,
+                      s21_big_decimal *big);
+double s21_big_to_binary(const s21_big_decimal *big, int scale, int prec);
+double s21_decimal_to_binary(s21_decimal src, int prec);
+void s21_big_integer(s21_decimal src, int flag, s21_big_decimal *big);
+uint64_t s21_mix64(uint64_t x);
+uint64_t s21_hash_canon(s21_decimal key);
+void s21_parse_fold(s21_parse_state *st);
+int s21_parse_eight(const char *p, uint32_t *val);
+int s21_parse_sixteen(const char *p, uint64_t *val);
+const char *s21_parse_run(const char *p, const char *last,
+                          s21_parse_state *st, int frac, int level);
+int s21_parse_exp(const char **p, const char *last);
+int s21_parse_finish(s21_big_decimal *big, int exp, int sticky, int sign,
+                     s21_decimal *out);
+int s21_chars_digits(s21_decimal value, char *end);
+s21_map_slot *s21_map_find(const s21_decimal_map *map, s21_decimal key,
+                           uint64_t hash);
+int s21_map_grow(s21_decimal_map *map);
+int s21_map_key(s21_decimal key, s21_decimal *canon, uint64_t *hash);
+int s21_map_insert_key(s21_decimal_map *map, s21_decimal key, uint64_t hash,
+                       size_t value, size_t *stored);
+int s21_group_cmp(s21_decimal a, s21_decimal b);
+void s21_group_scale_up(s21_big_decimal *sum, int num);
+void s21_group_add(s21_group *group, s21_decimal value, size_t row);
+void s21_group_combine(s21_group *group, const s21_group *other);
+int s21_group_slot(s21_group_table *table, s21_decimal canon, uint64_t hash,
+                   size_t *id);
+int s21_group_find(s21_group_table *table, s21_decimal key, size_t *id);
+int s21_group_row(s21_group_table *table, s21_decimal key, s21_decimal value,
+                  size_t row);
+int s21_group_merge(s21_group_table *table, const s21_group *group);
+void s21_group_hash_task(void *arg, size_t part, int worker);
+void s21_group_scatter_task(void *arg, size_t part, int worker);
+void s21_group_build_task(void *arg, size_t part, int worker);
+int s21_group_first_cmp(const void *a, const void *b);
+int s21_group_collect(s21_group_table *table, const s21_group_table *local);
+void s21_format_init(s21_format_job *job, const s21_decimal *src,
+                     const s21_decimal_column *col, size_t n,
+                     const s21_format_options *opt);
+s21_to_chars_result s21_format_range(const s21_format_job *job, size_t begin,
+                                     size_t end, char *first, char *last);
+void s21_format_task(void *arg, size_t part, int worker);
+s21_to_chars_result s21_format_run(s21_pool *pool, s21_format_job *job,
+                                   char *first, char *last);
 
 #endif  // SRC_S21_DECIMAL_H_
@@ -0,0 +1,212 @@
+#include "s21_decimal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Верхняя граница длины пакетной записи n чисел: каждое число не
+ * длиннее FORMAT_CHARS символов и знаков точности
+ *
+ * @param n количество чисел
+ * @param opt настройки записи
+ * @param Владимир
+ * @return size_t количество символов, которого всегда хватает
+ */
+size_t s21_format_bound(size_t n, const s21_format_options *opt) {
+  size_t sep = opt->separator ? strlen(opt->separator) : 0;
+  size_t value = FORMAT_CHARS + (opt->precision > 0 ? opt->precision : 0);
+  return n ? n * (value + sep) - sep : 0;
+}
+
+/**
+ * @brief Заполнение аргументов пакетной записи
+ *
+ * @param job указатель на аргументы
+ * @param src массив чисел или NULL
+ * @param col колонка чисел, если src равен NULL
+ * @param n количество чисел
+ * @param opt настройки записи
+ * @param Владимир
+ */
+void s21_format_init(s21_format_job *job, const s21_decimal *src,
+                     const s21_decimal_column *col, size_t n,
+                     const s21_format_options *opt) {
+  *job = (s21_format_job){.src = src, .col = col, .n = n};
+  job->separator = opt->separator ? opt->separator : "";
+  job->separator_len = strlen(job->separator);
+  job->precision = opt->precision;
+  job->stride = s21_format_bound(1, opt) + job->separator_len;
+}
+
+/**
+ * @brief Запись чисел с номерами от begin до end подряд, после каждого
+ * числа, кроме последнего из n, пишется разделитель
+ *
+ * @param job указатель на аргументы
+ * @param begin номер первого числа
+ * @param end номер за последним числом
+ * @param first начало буфера
+ * @param last конец буфера
+ * @param Владимир
+ * @return s21_to_chars_result конец записи и код ошибки
+ */
+s21_to_chars_result s21_format_range(const s21_format_job *job, size_t begin,
+                                     size_t end, char *first, char *last) {
+  s21_to_chars_result rez = {first, OK};
+  s21_decimal value;
+  for (size_t i = begin; i < end && rez.error == OK; i++) {
+    if (job->src)
+      value = job->src[i];
+    else
+      s21_column_get(job->col, i, &value);
+    rez = s21_to_chars_fixed(rez.ptr, last, value, job->precision);
+    if (rez.error == OK && i + 1 < job->n) {
+      if ((size_t)(last - rez.ptr) >= job->separator_len) {
+        memcpy(rez.ptr, job->separator, job->separator_len);
+        rez.ptr += job->separator_len;
+      } else {
+        rez = (s21_to_chars_result){last, ERROR};
+      }
+    }
+  }
+  return rez;
+}
+
+/**
+ * @brief Кусок параллельной записи: числа куска пишутся с начала его места
+ * в буфере, место рассчитано на stride символов для каждого числа
+ *
+ * @param arg указатель на s21_format_job
+ * @param part номер куска
+ * @param worker номер исполнителя
+ * @param Владимир
+ */
+void s21_format_task(void *arg, size_t part, int worker) {
+  s21_format_job *job = arg;
+  size_t begin = part * PAR_CHUNK;
+  size_t end = job->n - begin < PAR_CHUNK ? job->n : begin + PAR_CHUNK;
+  char *first = job->first + begin * job->stride;
+  size_t room = (end - begin) * job->stride;
+  // у последнего куска нет разделителя в конце, место ограничено буфером
+  char *last = (size_t)(job->last - first) < room ? job->last : first + room;
+  s21_to_chars_result rez = s21_format_range(job, begin, end, first, last);
+  job->len[part] = rez.error == OK ? (size_t)(rez.ptr - first) : SIZE_MAX;
+  (void)worker;
+}
+
+/**
+ * @brief Пакетная запись, куски которой при нескольких потоках пишутся
+ * параллельно в свои места буфера и затем сдвигаются к началу по порядку.
+ * Если буфер меньше s21_format_bound, запись идет в вызывающем потоке
+ *
+ * @param pool указатель на пул или NULL
+ * @param job указатель на аргументы
+ * @param first начало буфера
+ * @param last конец буфера
+ * @param Владимир
+ * @return s21_to_chars_result конец записи и код ошибки
+ */
+s21_to_chars_result s21_format_run(s21_pool *pool, s21_format_job *job,
+                                   char *first, char *last) {
+  s21_to_chars_result rez = {last, ERROR};
+  size_t parts = (job->n + PAR_CHUNK - 1) / PAR_CHUNK;
+  size_t bound = job->n ? job->n * job->stride - job->separator_len : 0;
+  size_t *len = NULL;
+  if (s21_pool_threads(pool) > 1 && parts > 1 &&
+      (size_t)(last - first) >= bound)
+    len = malloc(parts * sizeof(size_t));
+  if (len) {
+    job->first = first, job->last = last, job->len = len;
+    s21_pool_run(pool, s21_format_task, job, parts);
+    char *p = first;
+    size_t part = 0;
+    for (; part < parts && len[part] != SIZE_MAX; part++) {
+      memmove(p, first + part * PAR_CHUNK * job->stride, len[part]);
+      p += len[part];
+    }
+    if (part == parts) rez = (s21_to_chars_result){p, OK};
+    free(len);
+  } else {
+    rez = s21_format_range(job, 0, job->n, first, last);
+  }
+  return rez;
+}
+
+/**
+ * @brief Запись массива чисел текстом подряд через разделитель в буфер
+ * [first, last), каждое число записывается как s21_to_chars_fixed
+ *
+ * @param first начало буфера
+ * @param last конец буфера
+ * @param src массив чисел
+ * @param n количество чисел
+ * @param opt настройки записи
+ * @param Владимир
+ * @return s21_to_chars_result конец записи и код ошибки
+ */
+s21_to_chars_result s21_format(char *first, char *last, const s21_decimal *src,
+                               size_t n, const s21_format_options *opt) {
+  s21_format_job job;
+  s21_format_init(&job, src, NULL, n, opt);
+  return s21_format_range(&job, 0, n, first, last);
+}
+
+/**
+ * @brief Запись колонки чисел текстом, как s21_format
+ *
+ * @param first начало буфера
+ * @param last конец буфера
+ * @param col указатель на колонку
+ * @param opt настройки записи
+ * @param Владимир
+ * @return s21_to_chars_result конец записи и код ошибки
+ */
+s21_to_chars_result s21_column_format(char *first, char *last,
+                                      const s21_decimal_column *col,
+                                      const s21_format_options *opt) {
+  s21_format_job job;
+  s21_format_init(&job, NULL, col, col->size, opt);
+  return s21_format_range(&job, 0, col->size, first, last);
+}
+
+/**
+ * @brief Параллельная запись массива чисел текстом. Запись совпадает с
+ * s21_format при любом количестве потоков, для параллельной работы буфер
+ * должен вмещать s21_format_bound символов
+ *
+ * @param pool указатель на пул или NULL для записи в вызывающем потоке
+ * @param first начало буфера
+ * @param last конец буфера
+ * @param src массив чисел
+ * @param n количество чисел
+ * @param opt настройки записи
+ * @param Владимир
+ * @return s21_to_chars_result конец записи и код ошибки
+ */
+s21_to_chars_result s21_par_format(s21_pool *pool, char *first, char *last,
+                                   const s21_decimal *src, size_t n,
+                                   const s21_format_options *opt) {
+  s21_format_job job;
+  s21_format_init(&job, src, NULL, n, opt);
+  return s21_format_run(pool, &job, first, last);
+}
+
+/**
+ * @brief Параллельная запись колонки чисел текстом, как s21_par_format
+ *
+ * @param pool указатель на пул или NULL для записи в вызывающем потоке
+ * @param first начало буфера
+ * @param last конец буфера
+ * @param col указатель на колонку
+ * @param opt настройки записи
+ * @param Владимир
+ * @return s21_to_chars_result конец записи и код ошибки
+ */
+s21_to_chars_result s21_par_column_format(s21_pool *pool, char *first,
+                                          char *last,
+                                          const s21_decimal_column *col,
+                                          const s21_format_options *opt) {
+  s21_format_job job;
+  s21_format_init(&job, NULL, col, col->size, opt);
+  return s21_format_run(pool, &job, first, last);
+}
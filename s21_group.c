@@ -0,0 +1,519 @@
+#include "s21_decimal.h"
+
+#include <stdlib.h>
+
+// аргументы параллельной группировки: строки раскладываются по разделам
+// старшими битами хеша ключа, каждый раздел группируется отдельно
+typedef struct {
+  const s21_decimal *keys, *values;
+  const uint8_t *valid;
+  size_t n, base;
+  uint8_t *part;       // раздел строки, 0xff - строка пропускается
+  s21_decimal *canon;  // канонические ключи строк
+  uint64_t *hash;      // хеши ключей строк
+  size_t *offset;      // счетчики, затем позиции кусков в разделах
+  size_t *bound;       // начала разделов в rows
+  size_t *rows;        // номера строк по разделам
+  s21_group_table *local;
+  int *error;
+} s21_group_job;
+
+/**
+ * @brief Создание пустой таблицы групп
+ *
+ * @param table указатель на таблицу
+ * @param capacity ожидаемое количество групп
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_group_init(s21_group_table *table, size_t capacity) {
+  if (capacity < MAP_MIN) capacity = MAP_MIN;
+  int flag = s21_map_init(&table->map, capacity);
+  table->group = malloc(capacity * sizeof(s21_group));
+  table->size = 0;
+  table->rows = 0;
+  table->capacity = table->group ? capacity : 0;
+  if (flag != OK || !table->group) {
+    s21_group_free(table);
+    flag = ERROR;
+  }
+  return flag;
+}
+
+/**
+ * @brief Освобождение памяти таблицы групп
+ *
+ * @param table указатель на таблицу
+ * @param Владимир
+ */
+void s21_group_free(s21_group_table *table) {
+  s21_map_free(&table->map);
+  free(table->group);
+  table->group = NULL;
+  table->size = 0;
+  table->capacity = 0;
+}
+
+/**
+ * @brief Сравнение двух чисел: при одинаковой степени сравниваются мантиссы
+ * со знаком, иначе вызывается s21_compare
+ *
+ * @param a первое число
+ * @param b второе число
+ * @param Владимир
+ *
+ * @return int - -1, 0 или 1, как s21_compare
+ */
+int s21_group_cmp(s21_decimal a, s21_decimal b) {
+  int rez;
+  if (((a.bits[3] ^ b.bits[3]) & 0x00ff0000) == 0) {
+    uint64_t a_lo = (uint32_t)a.bits[0] | (uint64_t)(uint32_t)a.bits[1] << 32;
+    uint64_t b_lo = (uint32_t)b.bits[0] | (uint64_t)(uint32_t)b.bits[1] << 32;
+    uint32_t a_hi = (uint32_t)a.bits[2], b_hi = (uint32_t)b.bits[2];
+    int a_sign = (uint32_t)a.bits[3] >> 31, b_sign = (uint32_t)b.bits[3] >> 31;
+    int mag = a_hi != b_hi ? (a_hi > b_hi ? 1 : -1)
+              : a_lo != b_lo ? (a_lo > b_lo ? 1 : -1)
+                             : 0;
+    if (!(a_lo | a_hi | b_lo | b_hi))
+      rez = 0;
+    else if (a_sign != b_sign)
+      rez = a_sign ? -1 : 1;
+    else
+      rez = a_sign ? -mag : mag;
+  } else {
+    rez = s21_compare(a, b);
+  }
+  return rez;
+}
+
+/**
+ * @brief Умножение суммы в дополнительном коде на 10 в степени num
+ *
+ * @param sum указатель на сумму
+ * @param num показатель степени
+ * @param Владимир
+ */
+void s21_group_scale_up(s21_big_decimal *sum, int num) {
+  s21_big_decimal zero = {{0}};
+  int neg = sum->bits[BIG_LIMBS - 1] >> 31;
+  if (neg) s21_big_sub(&zero, sum, sum);
+  s21_big_scale_up(sum, num);
+  if (neg) s21_big_sub(&zero, sum, sum);
+}
+
+/**
+ * @brief Точное прибавление числа к группе. При степени, равной степени
+ * суммы, мантисса складывается с суммой пословно до последнего переноса,
+ * модуль суммы меньше 2^253 и не переполняет 384 бита
+ *
+ * @param group указатель на группу
+ * @param value значение со степенью не больше 28
+ * @param row номер строки
+ * @param Владимир
+ */
+void s21_group_add(s21_group *group, s21_decimal value, size_t row) {
+  int scale = s21_scale(value), sign = (uint32_t)value.bits[3] >> 31;
+  if (!group->count) {
+    group->sum = (s21_big_decimal){{0}};
+    group->scale = scale;
+    group->min = value;
+    group->max = value;
+    group->first = row;
+  } else {
+    if (s21_group_cmp(value, group->min) < 0) group->min = value;
+    if (s21_group_cmp(value, group->max) > 0) group->max = value;
+  }
+  if (scale > group->scale) {
+    s21_group_scale_up(&group->sum, scale - group->scale);
+    group->scale = scale;
+  }
+  if (scale == group->scale) {
+    uint32_t *sum = group->sum.bits;
+    uint64_t carry = 0;
+    for (int i = 0; i < BIG_LIMBS; i++) {
+      uint64_t word = i < 3 ? (uint32_t)value.bits[i] : 0;
+      uint64_t temp = sign ? (uint64_t)sum[i] - word - carry
+                           : (uint64_t)sum[i] + word + carry;
+      sum[i] = (uint32_t)temp;
+      carry = temp >> 32 & 1u;
+      if (i >= 2 && !carry) break;
+    }
+  } else {
+    s21_big_decimal big;
+    s21_to_big(value, &big);
+    s21_big_scale_up(&big, group->scale - scale);
+    if (sign)
+      s21_big_sub(&group->sum, &big, &group->sum);
+    else
+      s21_big_add(&group->sum, &big, &group->sum);
+  }
+  group->count++;
+}
+
+/**
+ * @brief Объединение группы с группой того же ключа, все строки которой
+ * идут позже
+ *
+ * @param group указатель на группу
+ * @param other указатель на добавляемую группу
+ * @param Владимир
+ */
+void s21_group_combine(s21_group *group, const s21_group *other) {
+  s21_big_decimal sum = other->sum;
+  if (other->scale > group->scale) {
+    s21_group_scale_up(&group->sum, other->scale - group->scale);
+    group->scale = other->scale;
+  }
+  s21_group_scale_up(&sum, group->scale - other->scale);
+  s21_big_add(&group->sum, &sum, &group->sum);
+  if (s21_group_cmp(other->min, group->min) < 0) group->min = other->min;
+  if (s21_group_cmp(other->max, group->max) > 0) group->max = other->max;
+  group->count += other->count;
+}
+
+/**
+ * @brief Номер группы канонического ключа с готовым хешем, новая группа
+ * добавляется в конец таблицы
+ *
+ * @param table указатель на таблицу
+ * @param canon канонический ключ
+ * @param hash хеш ключа от s21_map_key
+ * @param id указатель на номер группы
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_group_slot(s21_group_table *table, s21_decimal canon, uint64_t hash,
+                   size_t *id) {
+  int flag = OK;
+  if (table->size == table->capacity) {
+    s21_group *group =
+        realloc(table->group, 2 * table->capacity * sizeof(s21_group));
+    if (group) {
+      table->group = group;
+      table->capacity *= 2;
+    } else {
+      flag = ERROR;
+    }
+  }
+  if (flag == OK)
+    flag = s21_map_insert_key(&table->map, canon, hash, table->size, id);
+  if (flag == OK && *id == table->size) {
+    table->group[*id].key = canon;
+    table->group[*id].count = 0;
+    table->size++;
+  }
+  return flag;
+}
+
+/**
+ * @brief Номер группы ключа, новая группа добавляется в конец таблицы
+ *
+ * @param table указатель на таблицу
+ * @param key ключ
+ * @param id указатель на номер группы
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_group_find(s21_group_table *table, s21_decimal key, size_t *id) {
+  s21_decimal canon;
+  uint64_t hash = 0;
+  int flag = s21_map_key(key, &canon, &hash);
+  if (flag == OK) flag = s21_group_slot(table, canon, hash, id);
+  return flag;
+}
+
+/**
+ * @brief Добавление одной строки в таблицу групп
+ *
+ * @param table указатель на таблицу
+ * @param key ключ
+ * @param value значение
+ * @param row номер строки
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_group_row(s21_group_table *table, s21_decimal key, s21_decimal value,
+                  size_t row) {
+  size_t id = 0;
+  int flag = s21_scale(value) <= MAXEXP ? OK : ERROR;
+  if (flag == OK) flag = s21_group_find(table, key, &id);
+  if (flag == OK) s21_group_add(&table->group[id], value, row);
+  return flag;
+}
+
+/**
+ * @brief Добавление готовой группы, строки которой идут позже строк
+ * таблицы с тем же ключом
+ *
+ * @param table указатель на таблицу
+ * @param group указатель на группу
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_group_merge(s21_group_table *table, const s21_group *group) {
+  size_t id = 0;
+  int flag = s21_group_find(table, group->key, &id);
+  if (flag == OK) {
+    if (table->group[id].count)
+      s21_group_combine(&table->group[id], group);
+    else
+      table->group[id] = *group;
+  }
+  return flag;
+}
+
+/**
+ * @brief Группировка массивов ключей и значений: для каждого ключа
+ * считаются точная сумма, количество, наименьшее и наибольшее значения
+ *
+ * @param table указатель на таблицу групп
+ * @param keys массив ключей
+ * @param values массив значений
+ * @param valid битовая маска значимых значений или NULL
+ * @param n количество строк
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_group_by(s21_group_table *table, const s21_decimal *keys,
+                 const s21_decimal *values, const uint8_t *valid, size_t n) {
+  int flag = OK;
+  for (size_t i = 0; i < n && flag == OK; i++)
+    if (s21_valid(valid, i))
+      flag = s21_group_row(table, keys[i], values[i], table->rows + i);
+  table->rows += n;
+  return flag;
+}
+
+/**
+ * @brief Группировка колонок ключей и значений, как s21_group_by
+ *
+ * @param table указатель на таблицу групп
+ * @param keys колонка ключей
+ * @param values колонка значений того же размера
+ * @param valid битовая маска значимых значений или NULL
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_column_group_by(s21_group_table *table,
+                        const s21_decimal_column *keys,
+                        const s21_decimal_column *values,
+                        const uint8_t *valid) {
+  int flag = keys->size == values->size ? OK : ERROR;
+  s21_decimal key, value;
+  for (size_t i = 0; i < keys->size && flag == OK; i++) {
+    if (!s21_valid(valid, i)) continue;
+    s21_column_get(keys, i, &key);
+    s21_column_get(values, i, &value);
+    flag = s21_group_row(table, key, value, table->rows + i);
+  }
+  table->rows += keys->size;
+  return flag;
+}
+
+/**
+ * @brief Задача пула: раздел каждой строки куска и счетчики строк куска по
+ * разделам
+ *
+ * @param arg указатель на s21_group_job
+ * @param part номер куска
+ * @param worker номер исполнителя
+ * @param Владимир
+ */
+void s21_group_hash_task(void *arg, size_t part, int worker) {
+  s21_group_job *job = arg;
+  size_t begin = part * PAR_CHUNK, end = begin + PAR_CHUNK;
+  size_t *count = job->offset + (part << GROUP_BITS);
+  if (end > job->n) end = job->n;
+  for (size_t i = begin; i < end; i++) {
+    job->part[i] = 0xff;
+    if (!s21_valid(job->valid, i)) continue;
+    if (s21_scale(job->values[i]) > MAXEXP ||
+        s21_map_key(job->keys[i], &job->canon[i], &job->hash[i]) != OK) {
+      job->error[part] = ERROR;
+    } else {
+      job->part[i] = (uint8_t)(job->hash[i] >> (64 - GROUP_BITS));
+      count[job->part[i]]++;
+    }
+  }
+  (void)worker;
+}
+
+/**
+ * @brief Задача пула: номера строк куска записываются в свои разделы по
+ * порядку, поэтому внутри раздела строки идут как в исходном массиве
+ *
+ * @param arg указатель на s21_group_job
+ * @param part номер куска
+ * @param worker номер исполнителя
+ * @param Владимир
+ */
+void s21_group_scatter_task(void *arg, size_t part, int worker) {
+  s21_group_job *job = arg;
+  size_t begin = part * PAR_CHUNK, end = begin + PAR_CHUNK;
+  size_t *offset = job->offset + (part << GROUP_BITS);
+  if (end > job->n) end = job->n;
+  for (size_t i = begin; i < end; i++)
+    if (job->part[i] != 0xff) job->rows[offset[job->part[i]]++] = i;
+  (void)worker;
+}
+
+/**
+ * @brief Задача пула: группировка строк одного раздела в его таблицу,
+ * ключи и хеши берутся готовыми из первого прохода
+ *
+ * @param arg указатель на s21_group_job
+ * @param part номер раздела
+ * @param worker номер исполнителя
+ * @param Владимир
+ */
+void s21_group_build_task(void *arg, size_t part, int worker) {
+  s21_group_job *job = arg;
+  s21_group_table *local = &job->local[part];
+  int flag = s21_group_init(local, 0);
+  for (size_t i = job->bound[part]; i < job->bound[part + 1] && flag == OK;
+       i++) {
+    size_t row = job->rows[i], id = 0;
+    flag = s21_group_slot(local, job->canon[row], job->hash[row], &id);
+    if (flag == OK)
+      s21_group_add(&local->group[id], job->values[row], job->base + row);
+  }
+  if (flag != OK) job->error[part] = ERROR;
+  (void)worker;
+}
+
+/**
+ * @brief Порядок групп по номеру первой строки для qsort
+ *
+ * @param a указатель на указатель на группу
+ * @param b указатель на указатель на группу
+ * @param Владимир
+ *
+ * @return int - результат сравнения
+ */
+int s21_group_first_cmp(const void *a, const void *b) {
+  size_t first_a = (*(s21_group *const *)a)->first;
+  size_t first_b = (*(s21_group *const *)b)->first;
+  return (first_a > first_b) - (first_a < first_b);
+}
+
+/**
+ * @brief Сбор групп всех разделов в таблицу в порядке первого появления
+ *
+ * @param table указатель на таблицу групп
+ * @param local таблицы разделов
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_group_collect(s21_group_table *table, const s21_group_table *local) {
+  size_t total = 0;
+  for (int p = 0; p < 1 << GROUP_BITS; p++) total += local[p].size;
+  s21_group **order = malloc((total ? total : 1) * sizeof(s21_group *));
+  int flag = order ? OK : ERROR;
+  if (flag == OK) {
+    size_t k = 0;
+    for (int p = 0; p < 1 << GROUP_BITS; p++)
+      for (size_t i = 0; i < local[p].size; i++)
+        order[k++] = &local[p].group[i];
+    qsort(order, total, sizeof(s21_group *), s21_group_first_cmp);
+    for (size_t i = 0; i < total && flag == OK; i++)
+      flag = s21_group_merge(table, order[i]);
+  }
+  free(order);
+  return flag;
+}
+
+/**
+ * @brief Параллельная группировка. Строки раскладываются на 2^GROUP_BITS
+ * разделов по старшим битам хеша ключа, чтобы таблица каждого раздела
+ * помещалась в кэш, разделы группируются независимо. Группы собираются в
+ * порядке первой строки, поэтому результат совпадает с s21_group_by при
+ * любом количестве потоков
+ *
+ * @param pool указатель на пул или NULL для вычисления в вызывающем потоке
+ * @param table указатель на таблицу групп
+ * @param keys массив ключей
+ * @param values массив значений
+ * @param valid битовая маска значимых значений или NULL
+ * @param n количество строк
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_par_group_by(s21_pool *pool, s21_group_table *table,
+                     const s21_decimal *keys, const s21_decimal *values,
+                     const uint8_t *valid, size_t n) {
+  size_t chunks = (n + PAR_CHUNK - 1) / PAR_CHUNK, parts = 1 << GROUP_BITS;
+  if (s21_pool_threads(pool) == 1 || chunks < 2)
+    return s21_group_by(table, keys, values, valid, n);
+  size_t errors = chunks > parts ? chunks : parts;
+  s21_group_job job = {.keys = keys, .values = values, .valid = valid,
+                       .n = n, .base = table->rows};
+  job.part = malloc(n);
+  job.canon = malloc(n * sizeof(s21_decimal));
+  job.hash = malloc(n * sizeof(uint64_t));
+  job.offset = calloc(chunks << GROUP_BITS, sizeof(size_t));
+  job.bound = malloc((parts + 1) * sizeof(size_t));
+  job.rows = malloc(n * sizeof(size_t));
+  job.local = calloc(parts, sizeof(s21_group_table));
+  job.error = calloc(errors, sizeof(int));
+  int flag = job.part && job.canon && job.hash && job.offset && job.bound &&
+                     job.rows && job.local && job.error
+                 ? OK
+                 : ERROR;
+  if (flag == OK) {
+    s21_pool_run(pool, s21_group_hash_task, &job, chunks);
+    for (size_t i = 0; i < chunks; i++) flag |= job.error[i];
+  }
+  if (flag == OK) {
+    size_t total = 0;
+    for (size_t p = 0; p < parts; p++) {
+      job.bound[p] = total;
+      for (size_t c = 0; c < chunks; c++) {
+        size_t count = job.offset[c << GROUP_BITS | p];
+        job.offset[c << GROUP_BITS | p] = total;
+        total += count;
+      }
+    }
+    job.bound[parts] = total;
+    s21_pool_run(pool, s21_group_scatter_task, &job, chunks);
+    s21_pool_run(pool, s21_group_build_task, &job, parts);
+    for (size_t p = 0; p < parts; p++) flag |= job.error[p];
+  }
+  if (flag == OK) flag = s21_group_collect(table, job.local);
+  if (flag == OK) table->rows += n;
+  for (size_t p = 0; job.local && p < parts; p++)
+    s21_group_free(&job.local[p]);
+  free(job.part);
+  free(job.canon);
+  free(job.hash);
+  free(job.offset);
+  free(job.bound);
+  free(job.rows);
+  free(job.local);
+  free(job.error);
+  return flag;
+}
+
+/**
+ * @brief Сумма группы в Decimal с одним бухгалтерским округлением
+ *
+ * @param group указатель на группу
+ * @param result результат
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_group_sum(const s21_group *group, s21_decimal *result) {
+  s21_big_decimal sum = group->sum, zero = {{0}};
+  int sign = sum.bits[BIG_LIMBS - 1] >> 31;
+  if (sign) s21_big_sub(&zero, &sum, &sum);
+  return s21_acc_result(&sum, group->scale, sign, OK, result);
+}
@@ -0,0 +1,248 @@
+#include "s21_decimal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Создание пустой таблицы, емкость округляется вверх до степени
+ * двойки, но не меньше MAP_MIN
+ *
+ * @param map указатель на таблицу
+ * @param capacity ожидаемое количество ключей
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_map_init(s21_decimal_map *map, size_t capacity) {
+  size_t cap = MAP_MIN;
+  // запас в четверть емкости держит пробы короткими
+  while (cap - cap / 4 < capacity) cap *= 2;
+  map->slot = calloc(cap, sizeof(s21_map_slot));
+  map->size = 0;
+  map->capacity = map->slot ? cap : 0;
+  return map->slot ? OK : ERROR;
+}
+
+/**
+ * @brief Освобождение памяти таблицы
+ *
+ * @param map указатель на таблицу
+ * @param Владимир
+ */
+void s21_map_free(s21_decimal_map *map) {
+  free(map->slot);
+  map->slot = NULL;
+  map->size = 0;
+  map->capacity = 0;
+}
+
+/**
+ * @brief Канонический вид ключа и его хеш, нулевой хеш занят под пустую
+ * ячейку и заменяется единицей
+ *
+ * @param key ключ
+ * @param canon указатель на канонический ключ
+ * @param hash указатель на хеш
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_map_key(s21_decimal key, s21_decimal *canon, uint64_t *hash) {
+  int flag = s21_normalize(key, canon);
+  if (flag == OK) {
+    *hash = s21_hash_canon(*canon);
+    if (*hash == 0) *hash = 1;
+  }
+  return flag;
+}
+
+/**
+ * @brief Поиск ячейки с ключом или первой пустой ячейки на его пути
+ * линейного пробирования
+ *
+ * @param map указатель на таблицу
+ * @param key канонический ключ
+ * @param hash хеш ключа
+ * @param Владимир
+ *
+ * @return s21_map_slot* - найденная ячейка
+ */
+s21_map_slot *s21_map_find(const s21_decimal_map *map, s21_decimal key,
+                           uint64_t hash) {
+  size_t mask = map->capacity - 1, i = (size_t)hash & mask;
+  s21_map_slot *slot = map->slot + i;
+  // ключи канонические, поэтому равные числа совпадают побитово
+  while (slot->hash != 0 &&
+         (slot->hash != hash || memcmp(&slot->key, &key, sizeof(key)) != 0)) {
+    i = (i + 1) & mask;
+    slot = map->slot + i;
+  }
+  return slot;
+}
+
+/**
+ * @brief Увеличение емкости таблицы в два раза, хеши хранятся в ячейках и
+ * не пересчитываются
+ *
+ * @param map указатель на таблицу
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_map_grow(s21_decimal_map *map) {
+  int flag = ERROR;
+  size_t cap = map->capacity * 2;
+  s21_map_slot *slot = calloc(cap, sizeof(s21_map_slot));
+  if (slot) {
+    s21_decimal_map next = {slot, map->size, cap};
+    for (size_t i = 0; i < map->capacity; i++) {
+      if (map->slot[i].hash != 0) {
+        *s21_map_find(&next, map->slot[i].key, map->slot[i].hash) =
+            map->slot[i];
+      }
+    }
+    free(map->slot);
+    *map = next;
+    flag = OK;
+  }
+  return flag;
+}
+
+/**
+ * @brief Добавление канонического ключа с готовым хешем, если его еще нет
+ * в таблице
+ *
+ * @param map указатель на таблицу
+ * @param key канонический ключ
+ * @param hash хеш ключа от s21_map_key
+ * @param value значение для нового ключа
+ * @param stored указатель на значение ключа в таблице (может быть NULL)
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_map_insert_key(s21_decimal_map *map, s21_decimal key, uint64_t hash,
+                       size_t value, size_t *stored) {
+  int flag = OK;
+  s21_map_slot *slot = s21_map_find(map, key, hash);
+  if (slot->hash == 0) {
+    if (map->size + 1 > map->capacity - map->capacity / 4) {
+      flag = s21_map_grow(map);
+      if (flag == OK) slot = s21_map_find(map, key, hash);
+    }
+    if (flag == OK) {
+      slot->hash = hash;
+      slot->key = key;
+      slot->value = value;
+      map->size++;
+    }
+  }
+  if (flag == OK && stored) *stored = slot->value;
+  return flag;
+}
+
+/**
+ * @brief Добавление ключа, если его еще нет в таблице
+ *
+ * @param map указатель на таблицу
+ * @param key ключ
+ * @param value значение для нового ключа
+ * @param stored указатель на значение ключа в таблице (может быть NULL)
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_map_insert(s21_decimal_map *map, s21_decimal key, size_t value,
+                   size_t *stored) {
+  s21_decimal canon;
+  uint64_t hash = 0;
+  int flag = s21_map_key(key, &canon, &hash);
+  if (flag == OK) flag = s21_map_insert_key(map, canon, hash, value, stored);
+  return flag;
+}
+
+/**
+ * @brief Запись значения ключа с заменой старого
+ *
+ * @param map указатель на таблицу
+ * @param key ключ
+ * @param value значение
+ * @param Владимир
+ *
+ * @return int - код ошибки
+ */
+int s21_map_put(s21_decimal_map *map, s21_decimal key, size_t value) {
+  s21_decimal canon;
+  uint64_t hash = 0;
+  int flag = s21_map_key(key, &canon, &hash);
+  if (flag == OK) {
+    s21_map_slot *slot = s21_map_find(map, canon, hash);
+    if (slot->hash != 0) {
+      slot->value = value;
+    } else {
+      flag = s21_map_insert_key(map, canon, hash, value, NULL);
+    }
+  }
+  return flag;
+}
+
+/**
+ * @brief Чтение значения ключа
+ *
+ * @param map указатель на таблицу
+ * @param key ключ
+ * @param value указатель на значение (может быть NULL)
+ * @param Владимир
+ *
+ * @return int - TRUE, если ключ есть в таблице
+ */
+int s21_map_get(const s21_decimal_map *map, s21_decimal key, size_t *value) {
+  s21_decimal canon;
+  uint64_t hash = 0;
+  int found = FALSE;
+  if (s21_map_key(key, &canon, &hash) == OK) {
+    s21_map_slot *slot = s21_map_find(map, canon, hash);
+    if (slot->hash != 0) {
+      found = TRUE;
+      if (value) *value = slot->value;
+    }
+  }
+  return found;
+}
+
+/**
+ * @brief Удаление ключа со сдвигом следующих ячеек цепочки назад, таблица
+ * остается без надгробий
+ *
+ * @param map указатель на таблицу
+ * @param key ключ
+ * @param Владимир
+ *
+ * @return int - TRUE, если ключ был в таблице
+ */
+int s21_map_remove(s21_decimal_map *map, s21_decimal key) {
+  s21_decimal canon;
+  uint64_t hash = 0;
+  int found = FALSE;
+  if (s21_map_key(key, &canon, &hash) == OK) {
+    size_t mask = map->capacity - 1;
+    s21_map_slot *slot = s21_map_find(map, canon, hash);
+    if (slot->hash != 0) {
+      found = TRUE;
+      size_t hole = (size_t)(slot - map->slot), i = (hole + 1) & mask;
+      while (map->slot[i].hash != 0) {
+        // ячейка переезжает в дыру, если дыра лежит между ее домашней
+        // позицией и текущим местом
+        size_t home = (size_t)map->slot[i].hash & mask;
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+          map->slot[hole] = map->slot[i];
+          hole = i;
+        }
+        i = (i + 1) & mask;
+      }
+      memset(map->slot + hole, 0, sizeof(s21_map_slot));
+      map->size--;
+    }
+  }
+  return found;
+}
@@ -0,0 +1,361 @@
+#include "s21_decimal.h"
+
+#include <stdlib.h>
+
+#ifdef S21_THREADS
+#include <pthread.h>
+#endif
+
+struct s21_pool {
+  int threads;  // исполнителей вместе с вызывающим потоком
+#ifdef S21_THREADS
+  pthread_t *ids;
+  pthread_mutex_t lock;
+  pthread_cond_t start, done;
+  s21_task task;
+  void *arg;
+  size_t parts, next;
+  int started, busy, round, stop;
+#endif
+};
+
+// аргументы параллельной свертки, результаты хранятся по исполнителям
+typedef struct {
+  const s21_decimal *a, *b;
+  const uint8_t *valid;
+  size_t n;
+  int dir;
+  s21_accumulator *acc;
+  s21_decimal *best;
+  size_t *best_part;
+} s21_par_job;
+
+#ifdef S21_THREADS
+/**
+ * @brief Выполнение оставшихся кусков текущей задачи, вызывается под
+ * блокировкой пула и снимает ее на время работы с куском
+ *
+ * @param pool указатель на пул
+ * @param worker номер исполнителя
+ * @param Владимир
+ */
+void s21_pool_drain(s21_pool *pool, int worker) {
+  while (pool->next < pool->parts) {
+    size_t part = pool->next++;
+    pthread_mutex_unlock(&pool->lock);
+    pool->task(pool->arg, part, worker);
+    pthread_mutex_lock(&pool->lock);
+  }
+}
+
+/**
+ * @brief Цикл рабочего потока: ждет новую задачу, разбирает ее куски и
+ * сообщает о завершении
+ *
+ * @param data указатель на пул
+ * @param Владимир
+ * @return void* NULL
+ */
+void *s21_pool_worker(void *data) {
+  s21_pool *pool = data;
+  pthread_mutex_lock(&pool->lock);
+  // раунды считаются с создания пула, задача могла начаться до запуска
+  int worker = ++pool->started, seen = 0;
+  while (!pool->stop) {
+    if (pool->round == seen) {
+      pthread_cond_wait(&pool->start, &pool->lock);
+    } else {
+      seen = pool->round;
+      s21_pool_drain(pool, worker);
+      if (--pool->busy == 0) pthread_cond_signal(&pool->done);
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+#endif
+
+/**
+ * @brief Создание пула потоков. Без сборки с S21_THREADS пул выполняет
+ * задачи в вызывающем потоке
+ *
+ * @param threads количество потоков вместе с вызывающим
+ * @param Владимир
+ * @return s21_pool* указатель на пул или NULL при ошибке
+ */
+s21_pool *s21_pool_create(int threads) {
+  s21_pool *pool = calloc(1, sizeof(s21_pool));
+  if (pool) {
+    pool->threads = threads > 1 ? threads : 1;
+#ifdef S21_THREADS
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->ids = calloc((size_t)pool->threads, sizeof(pthread_t));
+    int count = 1;
+    while (pool->ids && count < pool->threads &&
+           !pthread_create(&pool->ids[count], NULL, s21_pool_worker, pool))
+      count++;
+    // если не все потоки запустились, пул работает с запущенными
+    pool->threads = count;
+#else
+    pool->threads = 1;
+#endif
+  }
+  return pool;
+}
+
+/**
+ * @brief Остановка потоков и освобождение пула
+ *
+ * @param pool указатель на пул или NULL
+ * @param Владимир
+ */
+void s21_pool_free(s21_pool *pool) {
+  if (pool) {
+#ifdef S21_THREADS
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = TRUE;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 1; i < pool->threads; i++) pthread_join(pool->ids[i], NULL);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->ids);
+#endif
+    free(pool);
+  }
+}
+
+/**
+ * @brief Количество исполнителей пула
+ *
+ * @param pool указатель на пул или NULL
+ * @param Владимир
+ * @return int количество потоков вместе с вызывающим, 1 для NULL
+ */
+int s21_pool_threads(const s21_pool *pool) { return pool ? pool->threads : 1; }
+
+/**
+ * @brief Выполнение задачи над parts кусками: куски разбираются
+ * исполнителями по очереди, вызывающий поток работает вместе с пулом и
+ * возвращается после завершения всех кусков
+ *
+ * @param pool указатель на пул или NULL
+ * @param task задача
+ * @param arg аргумент задачи
+ * @param parts количество кусков
+ * @param Владимир
+ */
+void s21_pool_run(s21_pool *pool, s21_task task, void *arg, size_t parts) {
+  if (s21_pool_threads(pool) == 1) {
+    for (size_t part = 0; part < parts; part++) task(arg, part, 0);
+  } else {
+#ifdef S21_THREADS
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task, pool->arg = arg;
+    pool->parts = parts, pool->next = 0;
+    pool->busy = pool->threads - 1;
+    pool->round++;
+    pthread_cond_broadcast(&pool->start);
+    s21_pool_drain(pool, 0);
+    while (pool->busy) pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+#endif
+  }
+}
+
+/**
+ * @brief Кусок суммы: значимые элементы прибавляются к сумматору исполнителя
+ *
+ * @param arg указатель на s21_par_job
+ * @param part номер куска
+ * @param worker номер исполнителя
+ * @param Владимир
+ */
+void s21_par_sum_task(void *arg, size_t part, int worker) {
+  s21_par_job *job = arg;
+  size_t begin = part * PAR_CHUNK;
+  size_t len = job->n - begin < PAR_CHUNK ? job->n - begin : PAR_CHUNK;
+  s21_acc_array(&job->acc[worker], job->a + begin,
+                job->valid ? job->valid + begin / 8 : NULL, len);
+}
+
+/**
+ * @brief Кусок скалярного произведения в сумматор исполнителя
+ *
+ * @param arg указатель на s21_par_job
+ * @param part номер куска
+ * @param worker номер исполнителя
+ * @param Владимир
+ */
+void s21_par_dot_task(void *arg, size_t part, int worker) {
+  s21_par_job *job = arg;
+  size_t begin = part * PAR_CHUNK;
+  size_t len = job->n - begin < PAR_CHUNK ? job->n - begin : PAR_CHUNK;
+  s21_acc_dot(&job->acc[worker], job->a + begin, job->b + begin, len);
+}
+
+/**
+ * @brief Кусок поиска наименьшего или наибольшего: лучший элемент куска
+ * сравнивается с лучшим у исполнителя, из равных остается элемент из куска
+ * с меньшим номером
+ *
+ * @param arg указатель на s21_par_job
+ * @param part номер куска
+ * @param worker номер исполнителя
+ * @param Владимир
+ */
+void s21_par_extreme_task(void *arg, size_t part, int worker) {
+  s21_par_job *job = arg;
+  size_t begin = part * PAR_CHUNK;
+  size_t len = job->n - begin < PAR_CHUNK ? job->n - begin : PAR_CHUNK;
+  s21_decimal value;
+  if (s21_extreme(job->a + begin, job->valid ? job->valid + begin / 8 : NULL,
+                  len, job->dir, &value) == OK) {
+    size_t *best_part = &job->best_part[worker];
+    int rez = *best_part == SIZE_MAX
+                  ? job->dir
+                  : s21_compare(value, job->best[worker]);
+    if (rez == job->dir || (rez == 0 && part < *best_part)) {
+      job->best[worker] = value;
+      *best_part = part;
+    }
+  }
+}
+
+/**
+ * @brief Параллельная точная сумма значимых элементов массива. У каждого
+ * исполнителя свой сумматор, сумматоры объединяются без округления, поэтому
+ * результат не зависит от количества потоков
+ *
+ * @param pool указатель на пул или NULL для вычисления в вызывающем потоке
+ * @param src массив слагаемых
+ * @param valid битовая маска значимых элементов или NULL
+ * @param n количество элементов
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки
+ */
+int s21_par_sum(s21_pool *pool, const s21_decimal *src, const uint8_t *valid,
+                size_t n, s21_decimal *result) {
+  int threads = s21_pool_threads(pool), ret;
+  s21_accumulator *acc = malloc((size_t)threads * sizeof(s21_accumulator));
+  if (acc) {
+    s21_par_job job = {.a = src, .valid = valid, .n = n, .acc = acc};
+    for (int i = 0; i < threads; i++) s21_acc_init(&acc[i]);
+    s21_pool_run(pool, s21_par_sum_task, &job,
+                 (n + PAR_CHUNK - 1) / PAR_CHUNK);
+    for (int i = 1; i < threads; i++) s21_acc_merge(&acc[0], &acc[i]);
+    ret = s21_acc_finalize(&acc[0], result);
+    free(acc);
+  } else {
+    ret = s21_sum(src, valid, n, result);
+  }
+  return ret;
+}
+
+/**
+ * @brief Параллельное скалярное произведение с одним округлением, так же
+ * как s21_par_sum
+ *
+ * @param pool указатель на пул или NULL для вычисления в вызывающем потоке
+ * @param a массив первых множителей
+ * @param b массив вторых множителей
+ * @param n количество элементов
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки
+ */
+int s21_par_dot(s21_pool *pool, const s21_decimal *a, const s21_decimal *b,
+                size_t n, s21_decimal *result) {
+  int threads = s21_pool_threads(pool), ret;
+  s21_accumulator *acc = malloc((size_t)threads * sizeof(s21_accumulator));
+  if (acc) {
+    s21_par_job job = {.a = a, .b = b, .n = n, .acc = acc};
+    for (int i = 0; i < threads; i++) s21_acc_init(&acc[i]);
+    s21_pool_run(pool, s21_par_dot_task, &job,
+                 (n + PAR_CHUNK - 1) / PAR_CHUNK);
+    for (int i = 1; i < threads; i++) s21_acc_merge(&acc[0], &acc[i]);
+    ret = s21_acc_finalize(&acc[0], result);
+    free(acc);
+  } else {
+    ret = s21_dot(a, b, n, result);
+  }
+  return ret;
+}
+
+/**
+ * @brief Параллельный поиск наименьшего или наибольшего значимого элемента.
+ * Лучшие элементы исполнителей сравниваются с учетом номера куска, поэтому
+ * результат совпадает с s21_extreme при любом количестве потоков
+ *
+ * @param pool указатель на пул или NULL для вычисления в вызывающем потоке
+ * @param src массив чисел
+ * @param valid битовая маска значимых элементов или NULL
+ * @param n количество элементов
+ * @param dir -1 - наименьший, 1 - наибольший
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_par_extreme(s21_pool *pool, const s21_decimal *src,
+                    const uint8_t *valid, size_t n, int dir,
+                    s21_decimal *result) {
+  int threads = s21_pool_threads(pool), ret = s21_NAN;
+  s21_decimal *best = malloc((size_t)threads * sizeof(s21_decimal));
+  size_t *best_part = malloc((size_t)threads * sizeof(size_t));
+  if (best && best_part) {
+    s21_par_job job = {.a = src, .valid = valid, .n = n, .dir = dir,
+                       .best = best, .best_part = best_part};
+    for (int i = 0; i < threads; i++) best_part[i] = SIZE_MAX;
+    s21_pool_run(pool, s21_par_extreme_task, &job,
+                 (n + PAR_CHUNK - 1) / PAR_CHUNK);
+    int win = -1;
+    for (int i = 0; i < threads; i++) {
+      if (best_part[i] == SIZE_MAX) continue;
+      int rez = win < 0 ? dir : s21_compare(best[i], best[win]);
+      if (rez == dir || (rez == 0 && best_part[i] < best_part[win])) win = i;
+    }
+    *result = win < 0 ? (s21_decimal){{0, 0, 0, 0}} : best[win];
+    ret = win < 0 ? s21_NAN : OK;
+  } else {
+    ret = s21_extreme(src, valid, n, dir, result);
+  }
+  free(best);
+  free(best_part);
+  return ret;
+}
+
+/**
+ * @brief Параллельный поиск наименьшего значимого элемента
+ *
+ * @param pool указатель на пул или NULL для вычисления в вызывающем потоке
+ * @param src массив чисел
+ * @param valid битовая маска значимых элементов или NULL
+ * @param n количество элементов
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_par_min(s21_pool *pool, const s21_decimal *src, const uint8_t *valid,
+                size_t n, s21_decimal *result) {
+  return s21_par_extreme(pool, src, valid, n, -1, result);
+}
+
+/**
+ * @brief Параллельный поиск наибольшего значимого элемента
+ *
+ * @param pool указатель на пул или NULL для вычисления в вызывающем потоке
+ * @param src массив чисел
+ * @param valid битовая маска значимых элементов или NULL
+ * @param n количество элементов
+ * @param result результат
+ * @param Владимир
+ * @return int возвращают код ошибки, s21_NAN если значимых элементов нет
+ */
+int s21_par_max(s21_pool *pool, const s21_decimal *src, const uint8_t *valid,
+                size_t n, s21_decimal *result) {
+  return s21_par_extreme(pool, src, valid, n, 1, result);
+}
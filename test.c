@@ -2,6 +2,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "s21_decimal.h"
 
@@ -277,6 +278,43 @@ START_TEST(test_s21_add) {
   ck_assert_int_eq((unsigned)result_our.bits[2], MAXBITS);
   ck_assert_int_eq((unsigned)result_our.bits[3], MINUS);
   ck_assert_int_eq(val, 0);
+
+  // 0.0000000000002+(-0.000000000000000207)=0.000000000000199793
+  src1 = dec_null;
+  src1.bits[0] = 2;
+  set_scale(&src1, 13);
+  src2 = dec_null;
+  src2.bits[0] = 207;
+  src2.bits[3] = MINUS;
+  set_scale(&src2, 18);
+  val = s21_add(src1, src2, &result_our);
+  ck_assert_int_eq(result_our.bits[0], 199793);
+  ck_assert_int_eq(result_our.bits[1], 0);
+  ck_assert_int_eq(result_our.bits[2], 0);
+  ck_assert_int_eq(result_our.bits[3], 18 << 16);
+  ck_assert_int_eq(val, OK);
+
+  // 79228162514264337593543950334+0.5=79228162514264337593543950334
+  src1 = dec_max;
+  src1.bits[0] = MAXBITS - 1;
+  src2 = dec_null;
+  src2.bits[0] = 5;
+  set_scale(&src2, 1);
+  val = s21_add(src1, src2, &result_our);
+  ck_assert_int_eq((unsigned)result_our.bits[0], MAXBITS - 1);
+  ck_assert_int_eq((unsigned)result_our.bits[1], MAXBITS);
+  ck_assert_int_eq((unsigned)result_our.bits[2], MAXBITS);
+  ck_assert_int_eq(result_our.bits[3], 0);
+  ck_assert_int_eq(val, OK);
+
+  // 1.50+1.50=3
+  src1 = dec_null;
+  src1.bits[0] = 150;
+  set_scale(&src1, 2);
+  val = s21_add(src1, src1, &result_our);
+  ck_assert_int_eq(result_our.bits[0], 3);
+  ck_assert_int_eq(result_our.bits[3], 0);
+  ck_assert_int_eq(val, OK);
 }
 END_TEST
 
@@ -669,6 +707,933 @@ START_TEST(test_s21_mul) {
   ck_assert_int_eq(0, result_our.bits[2]);
   ck_assert_int_eq(0, result_our.bits[3]);
   ck_assert_int_eq(val, NEGATIVE_INF);
+
+  // 7.9228162514264337593543950335 * 3 = 23.7684487542793012780631851
+  src1.bits[0] = MAXBITS;
+  src1.bits[1] = MAXBITS;
+  src1.bits[2] = MAXBITS;
+  src1.bits[3] = 0b00000000000111000000000000000000;
+  src2.bits[0] = 3;
+  src2.bits[1] = 0;
+  src2.bits[2] = 0;
+  src2.bits[3] = 0;
+
+  val = s21_mul(src1, src2, &result_our);
+  ck_assert_int_eq((unsigned)result_our.bits[0], 3642132267U);
+  ck_assert_int_eq((unsigned)result_our.bits[1], 3813930958U);
+  ck_assert_int_eq(result_our.bits[2], 12884901);
+  ck_assert_int_eq(result_our.bits[3], 25 << 16);
+  ck_assert_int_eq(val, OK);
+
+  // -0.5 * 0.0000000000000000000000000001 = 0
+  src1.bits[0] = 5;
+  src1.bits[1] = 0;
+  src1.bits[2] = 0;
+  src1.bits[3] = MINUS;
+  set_scale(&src1, 1);
+  src2.bits[0] = 1;
+  src2.bits[1] = 0;
+  src2.bits[2] = 0;
+  src2.bits[3] = 0;
+  set_scale(&src2, 28);
+
+  val = s21_mul(src1, src2, &result_our);
+  ck_assert_int_eq(0, result_our.bits[0]);
+  ck_assert_int_eq(0, result_our.bits[1]);
+  ck_assert_int_eq(0, result_our.bits[2]);
+  ck_assert_int_eq(0, result_our.bits[3]);
+  ck_assert_int_eq(val, OK);
+
+  // 0.51 * 1.0000000000000000000000000001 = 0.5100000000000000000000000001
+  src1.bits[0] = 51;
+  src1.bits[1] = 0;
+  src1.bits[2] = 0;
+  src1.bits[3] = 0;
+  set_scale(&src1, 2);
+  src2.bits[0] = 268435457;
+  src2.bits[1] = 1042612833;
+  src2.bits[2] = 542101086;
+  src2.bits[3] = 0;
+  set_scale(&src2, 28);
+
+  val = s21_mul(src1, src2, &result_our);
+  ck_assert_int_eq(result_our.bits[0], 1811939329);
+  ck_assert_int_eq((unsigned)result_our.bits[1], 4225404419U);
+  ck_assert_int_eq(result_our.bits[2], 276471553);
+  ck_assert_int_eq(result_our.bits[3], 28 << 16);
+  ck_assert_int_eq(val, OK);
+}
+END_TEST
+
+START_TEST(test_s21_fast_stats) {
+  s21_decimal val1 = {{150, 0, 0, 0}}, val2 = {{25, 0, 0, MINUS}}, rez;
+  s21_fast_stats stats;
+  set_scale(&val1, 2);
+  s21_reset_fast_stats();
+  ck_assert_int_eq(s21_add(val1, val2, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 235);
+  ck_assert_int_eq((unsigned)rez.bits[3], MINUS | (1 << 16));
+  ck_assert_int_eq(s21_mul(val1, val2, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 375);
+  ck_assert_int_eq((unsigned)rez.bits[3], MINUS | (1 << 16));
+  s21_get_fast_stats(&stats);
+  ck_assert(stats.fast == 2 && stats.slow == 0);
+
+  val1.bits[2] = 1;
+  ck_assert_int_eq(s21_sub(val1, val2, &rez), OK);
+  val1.bits[2] = 0;
+  val2.bits[1] = 1;
+  ck_assert_int_eq(s21_mul(val2, val2, &rez), OK);
+  s21_get_fast_stats(&stats);
+  ck_assert(stats.fast == 2 && stats.slow == 2);
+
+  s21_reset_fast_stats();
+  s21_get_fast_stats(&stats);
+  ck_assert(stats.fast == 0 && stats.slow == 0);
+}
+END_TEST
+
+START_TEST(test_s21_fma) {
+  s21_decimal val1 = {{5, 0, 0, 0}}, val2 = {{1, 0, 0, 0}}, rez, tmp;
+  s21_decimal val3 = {{268435457, 1042612833, 542101086, 0}};
+  set_scale(&val1, 1);
+  set_scale(&val2, 28);
+  set_scale(&val3, 28);
+  // 0.5 * 1e-28 + 1.0000000000000000000000000001: одно округление
+  ck_assert_int_eq(s21_fma(val1, val2, val3, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 268435458);
+  ck_assert_int_eq(rez.bits[1], 1042612833);
+  ck_assert_int_eq(rez.bits[2], 542101086);
+  ck_assert_int_eq(rez.bits[3], 28 << 16);
+  s21_mul(val1, val2, &tmp);
+  s21_add(tmp, val3, &tmp);
+  ck_assert_int_eq(tmp.bits[0], 268435457);
+
+  // 2.5 * -4 + 10 = 0
+  val2.bits[0] = 4;
+  val2.bits[3] = MINUS;
+  val3.bits[0] = 10;
+  val3.bits[1] = val3.bits[2] = val3.bits[3] = 0;
+  val1.bits[0] = 25;
+  ck_assert_int_eq(s21_fma(val1, val2, val3, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 0);
+  ck_assert_int_eq(rez.bits[3], 0);
+
+  // MAX * -2 + 1 = -INF
+  val1.bits[0] = val1.bits[1] = val1.bits[2] = MAXBITS;
+  val1.bits[3] = 0;
+  val2.bits[0] = 2;
+  val3.bits[0] = 1;
+  ck_assert_int_eq(s21_fma(val1, val2, val3, &rez), NEGATIVE_INF);
+  val2.bits[3] = 0;
+  ck_assert_int_eq(s21_fma(val1, val2, val3, &rez), INF);
+
+  // MAX * 1 - 0.5 = MAX - 1: половина до четного
+  val2.bits[0] = 1;
+  val3.bits[0] = 5;
+  val3.bits[3] = MINUS;
+  set_scale(&val3, 1);
+  ck_assert_int_eq(s21_fma(val1, val2, val3, &rez), OK);
+  ck_assert_int_eq((unsigned)rez.bits[0], MAXBITS - 1);
+  ck_assert_int_eq((unsigned)rez.bits[2], MAXBITS);
+}
+END_TEST
+
+START_TEST(test_s21_dot) {
+  s21_decimal qty[3] = {{{3, 0, 0, 0}}, {{25, 0, 0, 0}}, {{1, 0, 0, MINUS}}};
+  s21_decimal price[3] = {{{110, 0, 0, 0}}, {{400, 0, 0, 0}}, {{30, 0, 0, 0}}};
+  s21_decimal rez;
+  set_scale(&qty[1], 1);
+  for (int i = 0; i < 3; i++) set_scale(&price[i], 2);
+  // 3 * 1.10 + 2.5 * 4.00 - 1 * 0.30 = 13
+  ck_assert_int_eq(s21_dot(qty, price, 3, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 13);
+  ck_assert_int_eq(rez.bits[3], 0);
+
+  ck_assert_int_eq(s21_dot(qty, price, 0, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 0);
+
+  s21_accumulator acc, part;
+  s21_acc_init(&acc);
+  s21_acc_init(&part);
+  s21_acc_dot(&acc, qty, price, 1);
+  s21_acc_dot(&part, qty + 1, price + 1, 2);
+  s21_acc_merge(&acc, &part);
+  ck_assert_int_eq(s21_acc_finalize(&acc, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 13);
+
+  // 0.5 * 1e-28 + 1 * 1.0000000000000000000000000001: одно округление
+  s21_decimal a[2] = {{{5, 0, 0, 0}}, {{1, 0, 0, 0}}};
+  s21_decimal b[2] = {{{1, 0, 0, 0}}, {{268435457, 1042612833, 542101086, 0}}};
+  set_scale(&a[0], 1);
+  set_scale(&b[0], 28);
+  set_scale(&b[1], 28);
+  ck_assert_int_eq(s21_dot(a, b, 2, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 268435458);
+  ck_assert_int_eq(rez.bits[3], 28 << 16);
+
+  // MAX + MAX не помещается, MAX - MAX точно равно нулю
+  for (int i = 0; i < 2; i++) {
+    a[i].bits[0] = a[i].bits[1] = a[i].bits[2] = MAXBITS;
+    a[i].bits[3] = 0;
+    b[i] = (s21_decimal){{1, 0, 0, 0}};
+  }
+  ck_assert_int_eq(s21_dot(a, b, 2, &rez), INF);
+  b[1].bits[3] = MINUS;
+  ck_assert_int_eq(s21_dot(a, b, 2, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 0);
+  b[0].bits[3] = MINUS;
+  ck_assert_int_eq(s21_dot(a, b, 2, &rez), NEGATIVE_INF);
+}
+END_TEST
+
+START_TEST(test_s21_accumulator) {
+  s21_accumulator acc, part;
+  s21_decimal tenth = {{1, 0, 0, 0}}, rez, sum = {{0, 0, 0, 0}};
+  set_scale(&tenth, 1);
+  s21_acc_init(&acc);
+  s21_acc_init(&part);
+  for (int i = 0; i < 100000; i++) s21_acc_add(i % 2 ? &acc : &part, tenth);
+  s21_acc_merge(&acc, &part);
+  ck_assert_int_eq(s21_acc_finalize(&acc, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 10000);
+  ck_assert_int_eq(rez.bits[3], 0);
+
+  // MAX + MAX + 3e-28 - MAX - MAX: промежуточная сумма вне Decimal, итог точный
+  s21_decimal max = {{MAXBITS, MAXBITS, MAXBITS, 0}}, tiny = {{1, 0, 0, 0}};
+  set_scale(&tiny, 28);
+  s21_acc_init(&acc);
+  s21_acc_add(&acc, max);
+  s21_acc_add(&acc, max);
+  ck_assert_int_eq(s21_acc_finalize(&acc, &rez), INF);
+  for (int i = 0; i < 3; i++) {
+    s21_acc_add(&acc, tiny);
+    s21_add(sum, tiny, &sum);
+  }
+  s21_acc_sub(&acc, max);
+  s21_acc_sub(&acc, max);
+  ck_assert_int_eq(s21_acc_finalize(&acc, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 3);
+  ck_assert_int_eq(rez.bits[3], 28 << 16);
+  ck_assert_int_eq(s21_is_equal(rez, sum), TRUE);
+
+  s21_acc_sub(&acc, tenth);
+  ck_assert_int_eq(s21_acc_finalize(&acc, &rez), OK);
+  ck_assert_int_eq((unsigned)rez.bits[0], 3892314109u);
+  ck_assert_int_eq((unsigned)rez.bits[1], 2681241660u);
+  ck_assert_int_eq(rez.bits[2], 54210108);
+  ck_assert_int_eq((unsigned)rez.bits[3], MINUS | (28 << 16));
+}
+END_TEST
+
+START_TEST(test_s21_column) {
+  s21_decimal_column col, view;
+  s21_decimal val = {{0, 0, 0, 0}}, arr[40];
+  ck_assert_int_eq(s21_column_init(&col, 0), OK);
+  for (int i = 0; i < 40; i++) {
+    val.bits[0] = i;
+    val.bits[1] = i * 3;
+    val.bits[2] = MAXBITS - i;
+    val.bits[3] = (i % 29) << 16 | (i % 2 ? MINUS : 0);
+    ck_assert_int_eq(s21_column_append(&col, val), OK);
+  }
+  ck_assert_int_eq(col.size, 40);
+  ck_assert_int_eq((uintptr_t)col.lo % COLUMN_ALIGN, 0);
+  ck_assert_int_eq((uintptr_t)col.meta % COLUMN_ALIGN, 0);
+  ck_assert_int_eq(s21_column_get(&col, 37, &val), OK);
+  ck_assert_int_eq(val.bits[0], 37);
+  ck_assert_int_eq(val.bits[1], 111);
+  ck_assert_int_eq((unsigned)val.bits[2], MAXBITS - 37);
+  ck_assert_int_eq((unsigned)val.bits[3], 8 << 16 | MINUS);
+  ck_assert_int_eq(s21_column_get(&col, 40, &val), ERROR);
+
+  val.bits[3] = 29 << 16;
+  ck_assert_int_eq(s21_column_append(&col, val), ERROR);
+  ck_assert_int_eq(s21_column_set(&col, 3, val), ERROR);
+  val.bits[3] = 5 << 16;
+  ck_assert_int_eq(s21_column_set(&col, 3, val), OK);
+
+  ck_assert_int_eq(s21_column_slice(&col, 2, 5, &view), OK);
+  ck_assert_int_eq(view.size, 3);
+  ck_assert_int_eq(s21_column_get(&view, 1, &val), OK);
+  ck_assert_int_eq(val.bits[0], 37);
+  ck_assert_int_eq(val.bits[3], 5 << 16);
+  ck_assert_int_eq(s21_column_append(&view, val), ERROR);
+  ck_assert_int_eq(s21_column_slice(&col, 5, 41, &view), ERROR);
+  s21_column_free(&view);
+
+  s21_column_to_array(&col, arr);
+  s21_decimal_column copy;
+  ck_assert_int_eq(s21_column_init(&copy, 4), OK);
+  ck_assert_int_eq(s21_column_from_array(&copy, arr, 40), OK);
+  for (int i = 0; i < 40; i++) {
+    s21_column_get(&copy, i, &val);
+    for (int j = 0; j < 4; j++) ck_assert_int_eq(val.bits[j], arr[i].bits[j]);
+  }
+  s21_column_free(&copy);
+  s21_column_free(&col);
+}
+END_TEST
+
+START_TEST(test_s21_batch) {
+  s21_decimal a[4] = {{{10, 0, 0, 0}}, {{7, 0, 0, MINUS}},
+                      {{MAXBITS, MAXBITS, MAXBITS, 0}}, {{15, 0, 0, 0}}};
+  s21_decimal b[4] = {{{3, 0, 0, 0}}, {{2, 0, 0, 0}}, {{2, 0, 0, 0}},
+                      {{0, 0, 0, 0}}};
+  s21_decimal out[4], two = {{2, 0, 0, 0}};
+  int status[4];
+  set_scale(&a[3], 1);
+  ck_assert_int_eq(s21_add_n(a, b, out, status, 4), INF);
+  ck_assert_int_eq(out[0].bits[0], 13);
+  ck_assert_int_eq(out[1].bits[0], 5);
+  ck_assert_int_eq((unsigned)out[1].bits[3], MINUS);
+  ck_assert_int_eq(status[2], INF);
+  ck_assert_int_eq(status[3], OK);
+  ck_assert_int_eq(out[3].bits[0], 15);
+
+  ck_assert_int_eq(s21_div_n(a, b, out, status, 4), s21_NAN);
+  ck_assert_int_eq(status[0], OK);
+  ck_assert_int_eq(status[3], s21_NAN);
+  ck_assert_int_eq(out[1].bits[0], 35);
+  ck_assert_int_eq((unsigned)out[1].bits[3], MINUS | EXP1);
+  ck_assert_int_eq(s21_mod_n(a, b, out, NULL, 3), OK);
+  ck_assert_int_eq(out[0].bits[0], 1);
+
+  ck_assert_int_eq(s21_mul_scalar_n(a, two, out, status, 2), OK);
+  ck_assert_int_eq(out[0].bits[0], 20);
+  ck_assert_int_eq(out[1].bits[0], 14);
+  ck_assert_int_eq(s21_sub_scalar_n(a, two, out, status, 2), OK);
+  ck_assert_int_eq(out[0].bits[0], 8);
+  ck_assert_int_eq(out[1].bits[0], 9);
+  ck_assert_int_eq(s21_add_scalar_n(a, two, out, status, 2), OK);
+  ck_assert_int_eq(out[1].bits[0], 5);
+  ck_assert_int_eq(s21_div_scalar_n(a, two, out, status, 1), OK);
+  ck_assert_int_eq(out[0].bits[0], 5);
+  ck_assert_int_eq(s21_mod_scalar_n(a, two, out, status, 1), OK);
+  ck_assert_int_eq(out[0].bits[0], 0);
+
+  // результат на месте первого аргумента
+  ck_assert_int_eq(s21_sub_n(a, b, a, status, 2), OK);
+  ck_assert_int_eq(a[0].bits[0], 7);
+  ck_assert_int_eq(a[1].bits[0], 9);
+  ck_assert_int_eq(s21_mul_n(a, a, a, NULL, 2), OK);
+  ck_assert_int_eq(a[0].bits[0], 49);
+  ck_assert_int_eq(a[1].bits[0], 81);
+  ck_assert_int_eq(a[1].bits[3], 0);
+}
+END_TEST
+
+START_TEST(test_s21_column_add) {
+  s21_decimal a[37], b[37], val, expect;
+  s21_decimal_column col_a, col_b, out;
+  int status[37];
+  for (int i = 0; i < 37; i++) {
+    a[i] = (s21_decimal){{i * 1000003u, i % 3 ? 0 : MAXBITS, 0, 0}};
+    b[i] = (s21_decimal){{MAXBITS - i, i % 4 ? 7 : 0, 0, 0}};
+    set_scale(&a[i], i % 5 ? 2 : 0);
+    set_scale(&b[i], i % 7 ? 2 : 1);
+    if (i % 2) a[i].bits[3] |= MINUS;
+    if (i % 3 == 1) b[i].bits[3] |= MINUS;
+  }
+  // перенос за 96 бит без дробной части и с ней
+  a[20] = (s21_decimal){{MAXBITS, MAXBITS, MAXBITS, 0}};
+  b[20] = (s21_decimal){{1, 0, 0, 0}};
+  a[21] = (s21_decimal){{MAXBITS, MAXBITS, MAXBITS, MINUS}};
+  b[21] = (s21_decimal){{1, 0, 0, MINUS}};
+  a[22] = (s21_decimal){{MAXBITS, MAXBITS, MAXBITS, EXP1}};
+  b[22] = (s21_decimal){{9, 0, 0, EXP1}};
+  // разность равна нулю
+  b[23] = a[23];
+  s21_column_init(&col_a, 0);
+  s21_column_init(&col_b, 0);
+  s21_column_from_array(&col_a, a, 37);
+  s21_column_from_array(&col_b, b, 37);
+  for (int level = SIMD_SCALAR; level <= SIMD_AVX512; level++) {
+    s21_simd_limit(level);
+    for (int sub = 0; sub < 2; sub++) {
+      s21_column_init(&out, 0);
+      int rez = sub ? s21_column_sub(&col_a, &col_b, &out, status)
+                    : s21_column_add(&col_a, &col_b, &out, status);
+      ck_assert_int_eq(rez, sub ? OK : INF);
+      ck_assert_int_eq(out.size, 37);
+      for (int i = 0; i < 37; i++) {
+        int code = sub ? s21_sub(a[i], b[i], &expect)
+                       : s21_add(a[i], b[i], &expect);
+        ck_assert_int_eq(status[i], code);
+        s21_column_get(&out, i, &val);
+        if (code == OK) {
+          ck_assert_int_eq(s21_is_equal(val, expect), TRUE);
+          ck_assert_int_eq(val.bits[3] >> 31, expect.bits[3] >> 31);
+        }
+      }
+      s21_column_free(&out);
+    }
+  }
+  s21_simd_limit(SIMD_AVX512);
+  s21_column_init(&out, 0);
+  s21_column_sub(&col_a, &col_b, &out, NULL);
+  s21_column_get(&out, 23, &val);
+  ck_assert_int_eq(val.bits[0] | val.bits[1] | val.bits[2], 0);
+  ck_assert_int_eq(val.bits[3] >> 31, 0);
+  ck_assert_int_eq(s21_column_add(&col_a, &col_b, &out, NULL), INF);
+  s21_column_get(&out, 21, &val);
+  ck_assert_int_eq((unsigned)val.bits[3], MINUS);
+  // при одинаковой степени она сохраняется: 1.50 + 1.50 = 3.00
+  s21_column_get(&out, 1, &val);
+  ck_assert_int_eq(s21_scale(val), 2);
+  s21_column_free(&out);
+
+  // результат на месте первой колонки
+  ck_assert_int_eq(s21_column_sub(&col_a, &col_a, &col_a, status), OK);
+  s21_column_get(&col_a, 36, &val);
+  ck_assert_int_eq(val.bits[0] | val.bits[1] | val.bits[2], 0);
+  col_b.size--;
+  ck_assert_int_eq(s21_column_add(&col_a, &col_b, &col_a, NULL), ERROR);
+  s21_column_free(&col_a);
+  s21_column_free(&col_b);
+}
+END_TEST
+
+START_TEST(test_s21_aggregate) {
+  s21_decimal src[6] = {{{10, 0, 0, EXP1}},          {{100, 0, 0, 0}},
+                        {{25, 0, 0, MINUS | EXP1}}, {{0, 0, 0, MINUS}},
+                        {{MAXBITS, MAXBITS, MAXBITS, 0}},
+                        {{7, 0, 0, 0}}};
+  uint8_t valid = 0x2f;  // без src[4]
+  s21_decimal val;
+  set_scale(&src[1], 2);
+  ck_assert_int_eq(s21_count(&valid, 6), 5);
+  ck_assert_int_eq(s21_count(NULL, 6), 6);
+  // 1.0 + 1.00 - 2.5 + 0 + 7 = 6.5
+  ck_assert_int_eq(s21_sum(src, &valid, 6, &val), OK);
+  ck_assert_int_eq(val.bits[0], 65);
+  ck_assert_int_eq(val.bits[3], EXP1);
+  // 6.5 / 5 = 1.3
+  ck_assert_int_eq(s21_mean(src, &valid, 6, &val), OK);
+  ck_assert_int_eq(val.bits[0], 13);
+  ck_assert_int_eq(val.bits[3], EXP1);
+  ck_assert_int_eq(s21_min(src, &valid, 6, &val), OK);
+  ck_assert_int_eq((unsigned)val.bits[3], MINUS | EXP1);
+  // 7 больше 1.0 и 1.00, из равных 1.0 и 1.00 остается первое
+  ck_assert_int_eq(s21_max(src, &valid, 6, &val), OK);
+  ck_assert_int_eq(val.bits[0], 7);
+  ck_assert_int_eq(s21_max(src, NULL, 2, &val), OK);
+  ck_assert_int_eq(val.bits[3], EXP1);
+  ck_assert_int_eq(s21_min(src + 1, NULL, 2, &val), OK);
+  ck_assert_int_eq(val.bits[0], 25);
+  // сумма не помещается, среднее помещается: (2^96 - 1 + 7) / 2
+  ck_assert_int_eq(s21_sum(src + 4, NULL, 2, &val), INF);
+  ck_assert_int_eq(s21_mean(src + 4, NULL, 2, &val), OK);
+  ck_assert_int_eq(val.bits[0], 3);
+  ck_assert_int_eq(val.bits[1], 0);
+  ck_assert_int_eq((unsigned)val.bits[2], 0x80000000);
+  ck_assert_int_eq(val.bits[3], 0);
+  // 2 / 3 = 0.6666666666666666666666666667
+  src[0] = (s21_decimal){{1, 0, 0, 0}};
+  src[1] = (s21_decimal){{1, 0, 0, 0}};
+  src[2] = (s21_decimal){{0, 0, 0, 0}};
+  ck_assert_int_eq(s21_mean(src, NULL, 3, &val), OK);
+  ck_assert_int_eq(val.bits[0], 178956971);
+  ck_assert_int_eq(val.bits[1], 695075222);
+  ck_assert_int_eq(val.bits[2], 361400724);
+  ck_assert_int_eq(s21_scale(val), 28);
+  valid = 0;
+  ck_assert_int_eq(s21_mean(src, &valid, 6, &val), s21_NAN);
+  ck_assert_int_eq(s21_min(src, &valid, 6, &val), s21_NAN);
+  ck_assert_int_eq(s21_sum(src, &valid, 6, &val), OK);
+  ck_assert_int_eq(val.bits[0] | val.bits[3], 0);
+
+  // колонка с одной степенью суммируется по словам мантисс
+  s21_decimal_column col;
+  uint8_t mask[13];
+  s21_column_init(&col, 0);
+  for (int i = 0; i < 100; i++) {
+    s21_decimal item = {{3, MAXBITS, i, 0}};
+    set_scale(&item, 2);
+    if (i % 2) item.bits[3] |= MINUS;
+    s21_column_append(&col, item);
+  }
+  s21_decimal last = {{7, 0, 0, 0}};
+  set_scale(&last, 2);
+  s21_column_append(&col, last);
+  for (int i = 0; i < 13; i++) mask[i] = 0xff;
+  for (int level = SIMD_SCALAR; level <= SIMD_AVX512; level++) {
+    s21_simd_limit(level);
+    // пары (i, -(i + 1)) дают -50 * 2^64, итого (7 - 50 * 2^64) / 100
+    ck_assert_int_eq(s21_column_sum(&col, mask, &val), OK);
+    ck_assert_int_eq((unsigned)val.bits[0], 4294967289);
+    ck_assert_int_eq((unsigned)val.bits[1], MAXBITS);
+    ck_assert_int_eq(val.bits[2], 49);
+    ck_assert_int_eq((unsigned)val.bits[3], MINUS | (2 << 16));
+  }
+  mask[0] = 0xfe;
+  ck_assert_int_eq(s21_column_sum(&col, mask, &val), OK);
+  ck_assert_int_eq((unsigned)val.bits[0], 4294967292);
+  ck_assert_int_eq((unsigned)val.bits[1], 4294967294);
+  ck_assert_int_eq(val.bits[2], 50);
+  ck_assert_int_eq(s21_column_mean(&col, NULL, &val), OK);
+  ck_assert_int_eq((unsigned)val.bits[0], 2842206028);
+  ck_assert_int_eq((unsigned)val.bits[1], 2126221433);
+  ck_assert_int_eq(val.bits[2], 49504950);
+  ck_assert_int_eq((unsigned)val.bits[3], MINUS | (10 << 16));
+  ck_assert_int_eq(s21_column_min(&col, NULL, &val), OK);
+  ck_assert_int_eq(val.bits[2], 99);
+  ck_assert_int_eq(s21_column_max(&col, NULL, &val), OK);
+  ck_assert_int_eq(val.bits[2], 98);
+  ck_assert_int_eq(s21_column_max(&col, mask, &val), OK);
+  ck_assert_int_eq(val.bits[2], 98);
+  col.size = 0;
+  ck_assert_int_eq(s21_column_max(&col, NULL, &val), s21_NAN);
+  s21_column_free(&col);
+}
+END_TEST
+
+START_TEST(test_s21_parallel) {
+  size_t n = 3 * PAR_CHUNK + 123;
+  s21_decimal *src = malloc(n * sizeof(s21_decimal));
+  uint8_t *valid = malloc(n / 8 + 1);
+  ck_assert(src != NULL);
+  ck_assert(valid != NULL);
+  for (size_t i = 0; i < n; i++) {
+    src[i] = (s21_decimal){{(int)(i * 2654435761u), (int)(i % 5), 0, 0}};
+    set_scale(&src[i], (int)(i % 7));
+    if (i % 3 == 0) src[i].bits[3] |= MINUS;
+  }
+  for (size_t i = 0; i <= n / 8; i++) valid[i] = (uint8_t)(0xf7 ^ i);
+  // равные наименьшие -5.00 и -5.0 в разных кусках, первым идет -5.00
+  src[10] = (s21_decimal){{500, 0, 4000, MINUS}};
+  set_scale(&src[10], 2);
+  src[2 * PAR_CHUNK + 5] = (s21_decimal){{50, 0, 400, MINUS | EXP1}};
+  valid[1] |= 4, valid[(2 * PAR_CHUNK + 5) / 8] |= 1 << 5;
+  // соседи нулевые, чтобы скалярное произведение не переполнялось
+  src[9] = src[11] = src[2 * PAR_CHUNK + 4] = src[2 * PAR_CHUNK + 6] =
+      (s21_decimal){{0, 0, 0, 0}};
+  s21_decimal sum, dot, min, max, val;
+  ck_assert_int_eq(s21_sum(src, valid, n, &sum), OK);
+  ck_assert_int_eq(s21_dot(src, src + 1, n - 1, &dot), OK);
+  ck_assert_int_eq(s21_min(src, valid, n, &min), OK);
+  ck_assert_int_eq(s21_max(src, NULL, n, &max), OK);
+  ck_assert_int_eq(s21_scale(min), 2);
+  int threads[4] = {1, 2, 3, 4};
+  for (int k = 0; k < 4; k++) {
+    s21_pool *pool = s21_pool_create(threads[k]);
+    ck_assert(pool != NULL);
+    ck_assert_int_eq(s21_par_sum(pool, src, valid, n, &val), OK);
+    ck_assert_int_eq(memcmp(&val, &sum, sizeof(val)), 0);
+    ck_assert_int_eq(s21_par_dot(pool, src, src + 1, n - 1, &val), OK);
+    ck_assert_int_eq(memcmp(&val, &dot, sizeof(val)), 0);
+    ck_assert_int_eq(s21_par_min(pool, src, valid, n, &val), OK);
+    ck_assert_int_eq(memcmp(&val, &min, sizeof(val)), 0);
+    ck_assert_int_eq(s21_par_max(pool, src, NULL, n, &val), OK);
+    ck_assert_int_eq(memcmp(&val, &max, sizeof(val)), 0);
+    ck_assert_int_eq(s21_par_max(pool, src, NULL, 0, &val), s21_NAN);
+    ck_assert_int_eq(s21_par_sum(pool, src, NULL, 0, &val), OK);
+    ck_assert_int_eq(val.bits[0], 0);
+    s21_pool_free(pool);
+  }
+  ck_assert_int_eq(s21_par_sum(NULL, src, valid, n, &val), OK);
+  ck_assert_int_eq(memcmp(&val, &sum, sizeof(val)), 0);
+  free(src);
+  free(valid);
+}
+END_TEST
+
+START_TEST(test_s21_sort) {
+  // 1.0, -0, 2.5, -7, 1.00, 0, -2.50, 79228162514264337593543950335,
+  // -0.0000000000000000000000000001
+  s21_decimal src[9] = {{{10, 0, 0, EXP1}},
+                        {{0, 0, 0, MINUS}},
+                        {{25, 0, 0, EXP1}},
+                        {{7, 0, 0, MINUS}},
+                        {{100, 0, 0, 0}},
+                        {{0, 0, 0, 0}},
+                        {{250, 0, 0, MINUS}},
+                        {{MAXBITS, MAXBITS, MAXBITS, 0}},
+                        {{1, 0, 0, MINUS}}};
+  set_scale(&src[4], 2);
+  set_scale(&src[6], 2);
+  set_scale(&src[8], 28);
+  size_t perm[9], expect[9] = {3, 6, 8, 1, 5, 0, 4, 2, 7};
+  ck_assert_int_eq(s21_sort_index(src, 9, perm), OK);
+  for (int i = 0; i < 9; i++) ck_assert_int_eq(perm[i], expect[i]);
+
+  s21_decimal_column col;
+  s21_column_init(&col, 0);
+  s21_column_from_array(&col, src, 9);
+  ck_assert_int_eq(s21_column_sort_index(&col, perm), OK);
+  for (int i = 0; i < 9; i++) ck_assert_int_eq(perm[i], expect[i]);
+  s21_column_free(&col);
+
+  ck_assert_int_eq(s21_sort(src, 9), OK);
+  for (int i = 1; i < 9; i++)
+    ck_assert_int_le(s21_compare(src[i - 1], src[i]), 0);
+  ck_assert_int_eq((unsigned)src[3].bits[3], MINUS);
+  ck_assert_int_eq(src[5].bits[3], EXP1);
+  ck_assert_int_eq(s21_sort(src, 0), OK);
+}
+END_TEST
+
+START_TEST(test_s21_normalize) {
+  s21_decimal rez;
+  // 1.50 = 1.5
+  s21_decimal src = {{150, 0, 0, 0}};
+  set_scale(&src, 2);
+  ck_assert_int_eq(s21_normalize(src, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 15);
+  ck_assert_int_eq(rez.bits[3], EXP1);
+  // -100.00 = -100
+  src.bits[0] = 10000;
+  src.bits[3] = MINUS;
+  set_scale(&src, 2);
+  ck_assert_int_eq(s21_normalize(src, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 100);
+  ck_assert_int_eq((unsigned)rez.bits[3], MINUS);
+  // -0.000 = 0
+  src.bits[0] = 0;
+  ck_assert_int_eq(s21_normalize(src, &rez), OK);
+  ck_assert_int_eq(rez.bits[3], 0);
+  // 79228162514264337593543950330 / 10^28 = 7.922816251426433759354395033
+  src.bits[0] = MAXBITS - 5;
+  src.bits[1] = MAXBITS;
+  src.bits[2] = MAXBITS;
+  src.bits[3] = 0;
+  set_scale(&src, 28);
+  ck_assert_int_eq(s21_normalize(src, &rez), OK);
+  ck_assert_int_eq(s21_scale(rez), 27);
+  ck_assert_int_eq(s21_is_equal(src, rez), TRUE);
+  // 10^28 * 10^-28 = 1
+  src.bits[0] = 268435456;
+  src.bits[1] = 1042612833;
+  src.bits[2] = 542101086;
+  ck_assert_int_eq(s21_normalize(src, &rez), OK);
+  ck_assert_int_eq(rez.bits[0], 1);
+  ck_assert_int_eq(rez.bits[1] | rez.bits[2] | rez.bits[3], 0);
+  src.bits[3] = 0;
+  set_scale(&src, 29);
+  ck_assert_int_eq(s21_normalize(src, &rez), ERROR);
+
+  s21_decimal a = {{15, 0, 0, EXP1}}, b = {{1500, 0, 0, 0}};
+  set_scale(&b, 3);
+  ck_assert(s21_hash(a) == s21_hash(b));
+  a.bits[0] = 0;
+  b.bits[0] = 0;
+  b.bits[3] = MINUS;
+  ck_assert(s21_hash(a) == s21_hash(b));
+  b.bits[0] = 1;
+  ck_assert(s21_hash(a) != s21_hash(b));
+}
+END_TEST
+
+START_TEST(test_s21_map) {
+  s21_decimal_map map;
+  size_t value = 0;
+  ck_assert_int_eq(s21_map_init(&map, 0), OK);
+  ck_assert_int_eq(map.capacity, MAP_MIN);
+  // 1.5 и 1.50 - один ключ
+  s21_decimal a = {{15, 0, 0, EXP1}}, b = {{150, 0, 0, 0}};
+  set_scale(&b, 2);
+  ck_assert_int_eq(s21_map_insert(&map, a, 7, &value), OK);
+  ck_assert_int_eq(value, 7);
+  ck_assert_int_eq(s21_map_insert(&map, b, 8, &value), OK);
+  ck_assert_int_eq(value, 7);
+  ck_assert_int_eq(map.size, 1);
+  ck_assert_int_eq(s21_map_put(&map, b, 9), OK);
+  ck_assert_int_eq(s21_map_get(&map, a, &value), TRUE);
+  ck_assert_int_eq(value, 9);
+  b.bits[3] = 0;
+  set_scale(&b, 29);
+  ck_assert_int_eq(s21_map_insert(&map, b, 1, NULL), ERROR);
+  ck_assert_int_eq(s21_map_get(&map, b, NULL), FALSE);
+
+  // рост таблицы и удаление половины ключей
+  for (int i = 0; i < 1000; i++) {
+    s21_decimal key = {{i, 0, 0, i % 2 ? MINUS : 0}};
+    ck_assert_int_eq(s21_map_insert(&map, key, i, NULL), OK);
+  }
+  ck_assert_int_eq(map.size, 1001);
+  for (int i = 0; i < 1000; i += 2) {
+    s21_decimal key = {{i * 10, 0, 0, EXP1}};
+    ck_assert_int_eq(s21_map_remove(&map, key), TRUE);
+    ck_assert_int_eq(s21_map_remove(&map, key), FALSE);
+  }
+  ck_assert_int_eq(map.size, 501);
+  for (int i = 0; i < 1000; i++) {
+    s21_decimal key = {{i, 0, 0, i % 2 ? MINUS : 0}};
+    ck_assert_int_eq(s21_map_get(&map, key, &value), i % 2);
+    if (i % 2) ck_assert_int_eq(value, i);
+  }
+  ck_assert_int_eq(s21_map_get(&map, a, NULL), TRUE);
+  s21_map_free(&map);
+  ck_assert(map.slot == NULL);
+}
+END_TEST
+
+START_TEST(test_s21_group_by) {
+  // ключи 1.5, 2, 1.50, -0, 2, 0; значения 1, -2.5, 0.25, 7, 3, -1
+  s21_decimal keys[6] = {{{15, 0, 0, EXP1}}, {{2, 0, 0, 0}},
+                         {{150, 0, 0, 0}},   {{0, 0, 0, MINUS}},
+                         {{2, 0, 0, 0}},     {{0, 0, 0, 0}}};
+  s21_decimal values[6] = {{{1, 0, 0, 0}}, {{25, 0, 0, MINUS | EXP1}},
+                           {{25, 0, 0, 0}}, {{7, 0, 0, 0}},
+                           {{3, 0, 0, 0}},  {{1, 0, 0, MINUS}}};
+  set_scale(&keys[2], 2);
+  set_scale(&values[2], 2);
+  s21_group_table table;
+  s21_decimal sum;
+  ck_assert_int_eq(s21_group_init(&table, 0), OK);
+  ck_assert_int_eq(s21_group_by(&table, keys, values, NULL, 6), OK);
+  ck_assert_int_eq(table.size, 3);
+  // 1 + 0.25 = 1.25
+  ck_assert_int_eq(table.group[0].count, 2);
+  ck_assert_int_eq(s21_group_sum(&table.group[0], &sum), OK);
+  ck_assert_int_eq(sum.bits[0], 125);
+  ck_assert_int_eq(s21_scale(sum), 2);
+  ck_assert_int_eq(table.group[0].min.bits[0], 25);
+  ck_assert_int_eq(table.group[0].max.bits[0], 1);
+  // -2.5 + 3 = 0.5
+  ck_assert_int_eq(s21_group_sum(&table.group[1], &sum), OK);
+  ck_assert_int_eq(sum.bits[0], 5);
+  ck_assert_int_eq(sum.bits[3], EXP1);
+  // -0 и 0 - одна группа: 7 - 1 = 6
+  ck_assert_int_eq(table.group[2].key.bits[3], 0);
+  ck_assert_int_eq(s21_group_sum(&table.group[2], &sum), OK);
+  ck_assert_int_eq(sum.bits[0], 6);
+  ck_assert_int_eq((unsigned)table.group[2].min.bits[3], MINUS);
+
+  // пропуск незначимых строк и повторный вызов по той же таблице
+  uint8_t valid = 0x3e;
+  ck_assert_int_eq(s21_group_by(&table, keys, values, &valid, 6), OK);
+  ck_assert_int_eq(table.group[0].count, 3);
+  ck_assert_int_eq(table.group[2].count, 4);
+  ck_assert_int_eq(table.rows, 12);
+
+  // переполнение суммы: 3 * (2^96 - 1)
+  s21_decimal big[3] = {{{MAXBITS, MAXBITS, MAXBITS, 0}},
+                        {{MAXBITS, MAXBITS, MAXBITS, 0}},
+                        {{MAXBITS, MAXBITS, MAXBITS, 0}}};
+  s21_group_table other;
+  s21_group_init(&other, 0);
+  ck_assert_int_eq(s21_group_by(&other, keys, big, NULL, 3), OK);
+  ck_assert_int_eq(s21_group_sum(&other.group[0], &sum), INF);
+  s21_group_free(&other);
+
+  // параллельная группировка совпадает с последовательной
+  size_t n = 3 * PAR_CHUNK;
+  s21_decimal *k = malloc(n * sizeof(s21_decimal));
+  s21_decimal *v = malloc(n * sizeof(s21_decimal));
+  for (size_t i = 0; i < n; i++) {
+    k[i] = (s21_decimal){{(int)(i * 7919 % 1000), 0, 0, 0}};
+    v[i] = (s21_decimal){{(int)i, 0, 0, i % 3 ? EXP1 : MINUS}};
+  }
+  s21_group_init(&other, 0);
+  ck_assert_int_eq(s21_group_by(&other, k, v, NULL, n), OK);
+  for (int threads = 1; threads <= 4; threads++) {
+    s21_pool *pool = s21_pool_create(threads);
+    s21_group_table par;
+    s21_group_init(&par, 0);
+    ck_assert_int_eq(s21_par_group_by(pool, &par, k, v, NULL, n), OK);
+    ck_assert_int_eq(par.size, other.size);
+    for (size_t g = 0; g < par.size; g++) {
+      s21_decimal a, b;
+      s21_group_sum(&par.group[g], &a);
+      s21_group_sum(&other.group[g], &b);
+      ck_assert_int_eq(memcmp(&a, &b, sizeof(a)), 0);
+      ck_assert_int_eq(memcmp(&par.group[g].key, &other.group[g].key,
+                              sizeof(s21_decimal)),
+                       0);
+      ck_assert_int_eq(par.group[g].count, other.group[g].count);
+    }
+    s21_group_free(&par);
+    s21_pool_free(pool);
+  }
+  s21_group_free(&other);
+  free(k);
+  free(v);
+  s21_group_free(&table);
+}
+END_TEST
+
+START_TEST(test_s21_from_chars) {
+  s21_decimal rez;
+  const char *text = "-1.50e-2;";
+  s21_from_chars_result res = s21_from_chars(text, text + 9, &rez);
+  ck_assert_int_eq(res.error, OK);
+  ck_assert(res.ptr == text + 8);
+  ck_assert_int_eq(rez.bits[0], 150);
+  ck_assert_int_eq(s21_scale(rez), 4);
+  ck_assert_int_eq(s21_bit(rez, 127), 1);
+  // буфер без завершающего нуля: разбор останавливается на last
+  char *buf = malloc(3);
+  memcpy(buf, "125", 3);
+  res = s21_from_chars(buf, buf + 3, &rez);
+  ck_assert(res.ptr == buf + 3);
+  ck_assert_int_eq(rez.bits[0], 125);
+  res = s21_from_chars(buf, buf + 2, &rez);
+  ck_assert_int_eq(rez.bits[0], 12);
+  free(buf);
+  // 29 знаков дроби: 0.00000000000000000000000000025 -> 2 * 10^-28
+  text = "0.00000000000000000000000000025";
+  res = s21_from_chars(text, text + 31, &rez);
+  ck_assert_int_eq(rez.bits[0], 2);
+  ck_assert_int_eq(s21_scale(rez), 28);
+  // хвост за 38 значащими цифрами: половина плюс еще немного
+  text = "0.0000000000000000000000000002500000000000000000000000000000000001";
+  res = s21_from_chars(text, text + 66, &rez);
+  ck_assert_int_eq(rez.bits[0], 3);
+  text = "79228162514264337593543950335.5";
+  res = s21_from_chars(text, text + 31, &rez);
+  ck_assert_int_eq(res.error, INF);
+  text = "-8e28";
+  res = s21_from_chars(text, text + 5, &rez);
+  ck_assert_int_eq(res.error, NEGATIVE_INF);
+  text = "1e+";
+  res = s21_from_chars(text, text + 3, &rez);
+  ck_assert_int_eq(res.error, OK);
+  ck_assert(res.ptr == text + 1);
+  text = "-.e5";
+  res = s21_from_chars(text, text + 4, &rez);
+  ck_assert_int_eq(res.error, s21_NAN);
+  ck_assert(res.ptr == text);
+}
+END_TEST
+
+START_TEST(test_s21_from_chars_digits) {
+  // длинные цифры разбираются блоками, результат не зависит от уровня ядер
+  const char *text[] = {"1234567890123456789012345678",
+                        "0.1234567890123456789012345678901234567891",
+                        "-000000000000000000012345678.9x",
+                        "123456789012345678.1234567"};
+  s21_decimal rez;
+  for (int level = SIMD_SCALAR; level <= SIMD_AVX512; level++) {
+    s21_simd_limit(level);
+    s21_from_chars_result res =
+        s21_from_chars(text[0], text[0] + strlen(text[0]), &rez);
+    ck_assert_int_eq(res.error, OK);
+    ck_assert_int_eq(rez.bits[0], (int)3191403342u);
+    ck_assert_int_eq(rez.bits[1], 1836677777);
+    ck_assert_int_eq(rez.bits[2], 66926059);
+    ck_assert_int_eq(s21_scale(rez), 0);
+    s21_from_chars(text[1], text[1] + strlen(text[1]), &rez);
+    ck_assert_int_eq(rez.bits[0], (int)3191403343u);
+    ck_assert_int_eq(rez.bits[2], 66926059);
+    ck_assert_int_eq(s21_scale(rez), 28);
+    res = s21_from_chars(text[2], text[2] + strlen(text[2]), &rez);
+    ck_assert(res.ptr == text[2] + 30);
+    ck_assert_int_eq(rez.bits[0], 123456789);
+    ck_assert_int_eq(s21_scale(rez), 1);
+    ck_assert_int_eq(s21_bit(rez, 127), 1);
+    s21_from_chars(text[3], text[3] + strlen(text[3]), &rez);
+    // 18 цифр целой части собираются в одно слово, дробь добавляется
+    s21_decimal expect = {{0, 0, 0, 0}};
+    s21_from_chars(text[3], text[3] + 18, &expect);
+    s21_decimal frac = {{1234567, 0, 0, 7 << 16}};
+    s21_add(expect, frac, &expect);
+    ck_assert_int_eq(s21_is_equal(rez, expect), TRUE);
+    ck_assert_int_eq(s21_scale(rez), 7);
+  }
+  s21_simd_limit(SIMD_AVX512);
+}
+END_TEST
+
+START_TEST(test_s21_to_chars) {
+  char buf[64];
+  // -1.50: кратчайшая запись отбрасывает нули степени
+  s21_decimal val = {{150, 0, 0, MINUS | (2 << 16)}};
+  s21_to_chars_result res = s21_to_chars(buf, buf + 64, val);
+  ck_assert_int_eq(res.error, OK);
+  *res.ptr = 0;
+  ck_assert_str_eq(buf, "-1.5");
+  res = s21_to_chars_fixed(buf, buf + 64, val, 4);
+  *res.ptr = 0;
+  ck_assert_str_eq(buf, "-1.5000");
+  // 0.025 до двух знаков: половина от нуля
+  val = (s21_decimal){{25, 0, 0, 3 << 16}};
+  res = s21_to_chars_fixed(buf, buf + 64, val, 2);
+  *res.ptr = 0;
+  ck_assert_str_eq(buf, "0.03");
+  res = s21_to_chars(buf, buf + 64, val);
+  *res.ptr = 0;
+  ck_assert_str_eq(buf, "0.025");
+  // -0.004 до двух знаков становится нулем без знака
+  val = (s21_decimal){{4, 0, 0, MINUS | (3 << 16)}};
+  res = s21_to_chars_fixed(buf, buf + 64, val, 2);
+  *res.ptr = 0;
+  ck_assert_str_eq(buf, "0.00");
+  val = (s21_decimal){{0, 0, 0, 5 << 16}};
+  res = s21_to_chars(buf, buf + 64, val);
+  *res.ptr = 0;
+  ck_assert_str_eq(buf, "0");
+  val = (s21_decimal){{MAXBITS, MAXBITS, MAXBITS, 0}};
+  res = s21_to_chars(buf, buf + 64, val);
+  *res.ptr = 0;
+  ck_assert_str_eq(buf, DEC_MAX);
+  val.bits[3] = MAXEXP << 16;
+  res = s21_to_chars(buf, buf + 64, val);
+  *res.ptr = 0;
+  ck_assert_str_eq(buf, "7.9228162514264337593543950335");
+  // буфер на один символ меньше записи
+  res = s21_to_chars(buf, buf + 29, val);
+  ck_assert_int_eq(res.error, ERROR);
+  ck_assert(res.ptr == buf + 29);
+  val.bits[3] = (MAXEXP + 1) << 16;
+  res = s21_to_chars(buf, buf + 64, val);
+  ck_assert_int_eq(res.error, ERROR);
+  // запись читается обратно в то же число
+  val = (s21_decimal){{123456789, 987654321, 5, MINUS | (11 << 16)}};
+  res = s21_to_chars(buf, buf + 64, val);
+  s21_decimal back;
+  s21_from_chars(buf, res.ptr, &back);
+  ck_assert_int_eq(s21_is_equal(val, back), TRUE);
+}
+END_TEST
+
+START_TEST(test_s21_format) {
+  s21_decimal src[4] = {{{150, 0, 0, MINUS | (2 << 16)}},
+                        {{7, 0, 0, 0}},
+                        {{1, 0, 0, 3 << 16}},
+                        {{0, 0, 0, MINUS}}};
+  s21_format_options opt = {", ", CHARS_SHORTEST};
+  char buf[256];
+  s21_to_chars_result res = s21_format(buf, buf + 256, src, 4, &opt);
+  ck_assert_int_eq(res.error, OK);
+  *res.ptr = 0;
+  ck_assert_str_eq(buf, "-1.5, 7, 0.001, 0");
+  ck_assert_int_le(strlen(buf), s21_format_bound(4, &opt));
+  opt = (s21_format_options){NULL, 2};
+  s21_decimal_column col;
+  s21_column_init(&col, 0);
+  s21_column_from_array(&col, src, 4);
+  res = s21_column_format(buf, buf + 256, &col, &opt);
+  *res.ptr = 0;
+  ck_assert_str_eq(buf, "-1.507.000.000.00");
+  // буфер мал для разделителя после первого числа
+  opt.separator = ";";
+  res = s21_format(buf, buf + 5, src, 4, &opt);
+  ck_assert_int_eq(res.error, ERROR);
+  ck_assert(res.ptr == buf + 5);
+  s21_column_free(&col);
+  // параллельная запись совпадает с последовательной
+  size_t n = 3 * PAR_CHUNK + 5;
+  s21_decimal *big = malloc(n * sizeof(s21_decimal));
+  for (size_t i = 0; i < n; i++)
+    big[i] = (s21_decimal){{(int)(i * 2654435761u), (int)i, 0,
+                            (int)((i % 29) << 16 | (i % 2 ? MINUS : 0))}};
+  opt = (s21_format_options){",", CHARS_SHORTEST};
+  size_t bound = s21_format_bound(n, &opt);
+  char *seq = malloc(bound), *par = malloc(bound);
+  s21_to_chars_result want = s21_format(seq, seq + bound, big, n, &opt);
+  ck_assert_int_eq(want.error, OK);
+  for (int threads = 1; threads <= 4; threads++) {
+    s21_pool *pool = s21_pool_create(threads);
+    res = s21_par_format(pool, par, par + bound, big, n, &opt);
+    ck_assert_int_eq(res.error, OK);
+    ck_assert_int_eq(res.ptr - par, want.ptr - seq);
+    ck_assert_int_eq(memcmp(par, seq, want.ptr - seq), 0);
+    s21_pool_free(pool);
+  }
+  free(big);
+  free(seq);
+  free(par);
 }
 END_TEST
 
@@ -1042,6 +2007,49 @@ START_TEST(test_s21_is_greater_or_equal) {
 }
 END_TEST
 
+START_TEST(test_s21_compare) {
+  s21_decimal src1 = {{0, 0, 0, 0}}, src2 = {{0, 0, 0, 0}};
+
+  // -0 == 0.00
+  src1.bits[3] = MINUS;
+  set_scale(&src2, 2);
+  ck_assert_int_eq(s21_compare(src1, src2), 0);
+
+  // 1.50 == 1.5
+  src1.bits[0] = 150;
+  src1.bits[3] = 0;
+  set_scale(&src1, 2);
+  src2.bits[0] = 15;
+  src2.bits[3] = 0;
+  set_scale(&src2, 1);
+  ck_assert_int_eq(s21_compare(src1, src2), 0);
+
+  // -1.5 < 0.0000000000000000000000000001
+  src1.bits[3] ^= MINUS;
+  src2.bits[0] = 1;
+  src2.bits[3] = 0;
+  set_scale(&src2, 28);
+  ck_assert_int_eq(s21_compare(src1, src2), -1);
+  ck_assert_int_eq(s21_compare(src2, src1), 1);
+
+  // 79228162514264337593543950335 > 7922816251426433759354395033.5
+  src1.bits[0] = MAXBITS;
+  src1.bits[1] = MAXBITS;
+  src1.bits[2] = MAXBITS;
+  src1.bits[3] = 0;
+  src2 = src1;
+  set_scale(&src2, 1);
+  ck_assert_int_eq(s21_compare(src1, src2), 1);
+
+  // -79228162514264337593543950335 < -7.9228162514264337593543950335
+  src1.bits[3] = MINUS;
+  src2.bits[3] = MINUS;
+  set_scale(&src2, 28);
+  ck_assert_int_eq(s21_compare(src1, src2), -1);
+  ck_assert_int_eq(s21_compare(src1, src1), 0);
+}
+END_TEST
+
 START_TEST(test_s21_from_float_to_decimal) {
   s21_decimal val;
   s21_from_float_to_decimal(0.03F, &val);
@@ -1177,6 +2185,22 @@ START_TEST(test_s21_from_float_to_decimal) {
   ck_assert_int_eq(val.bits[1], 0);
   ck_assert_int_eq(val.bits[2], 0);
   ck_assert_int_eq((unsigned)val.bits[3], MINUS);
+
+  ck_assert_int_eq(s21_from_float_to_decimal(22610662.0F, &val), OK);
+  ck_assert_int_eq(val.bits[0], 22610660);
+  ck_assert_int_eq(val.bits[3], 0);
+
+  s21_from_float_to_decimal(2.5E-28F, &val);
+  ck_assert_int_eq(val.bits[0], 3);
+  ck_assert_int_eq(val.bits[3], 1835008);
+
+  ck_assert_int_eq(s21_from_float_to_decimal(7.9228162E+28F, &val), OK);
+  ck_assert_int_eq((unsigned)val.bits[0], 536870912u);
+  ck_assert_int_eq((unsigned)val.bits[1], 3012735514u);
+  ck_assert_int_eq((unsigned)val.bits[2], 4294967159u);
+  ck_assert_int_eq(val.bits[3], 0);
+
+  ck_assert_int_eq(s21_from_float_to_decimal(1E+29F, &val), ERROR);
 }
 END_TEST
 
@@ -1401,6 +2425,64 @@ START_TEST(test_s21_dec_to_float) {
   error = s21_from_decimal_to_float(rez, &my_float);
   ck_assert_float_eq(my_float, 0xFFFFFFFFFFFFFFFF);
   ck_assert_int_eq(error, OK);
+
+  rez.bits[0] = 16777217;
+  rez.bits[1] = 0;
+  rez.bits[2] = 0;
+  rez.bits[3] = 0;
+  error = s21_from_decimal_to_float(rez, &my_float);
+  ck_assert_float_eq(my_float, 16777216);
+  ck_assert_int_eq(error, OK);
+
+  rez.bits[0] = MAXBITS;
+  rez.bits[1] = MAXBITS;
+  rez.bits[2] = MAXBITS;
+  rez.bits[3] = MINUS;
+  error = s21_from_decimal_to_float(rez, &my_float);
+  ck_assert_float_eq(my_float, -7.9228163E+28F);
+  ck_assert_int_eq(error, OK);
+
+  rez.bits[0] = 0;
+  rez.bits[3] = 0;
+  set_scale(&rez, 28);
+  error = s21_from_decimal_to_float(rez, &my_float);
+  ck_assert_float_eq(my_float, 7.9228163F);
+  ck_assert_int_eq(error, OK);
+}
+END_TEST
+
+START_TEST(test_s21_dec_to_double) {
+  s21_decimal rez = {{1, 0, 0, 0}};
+  double my_double;
+  set_scale(&rez, 1);
+  int error = s21_from_decimal_to_double(rez, &my_double);
+  ck_assert_double_eq(my_double, 0.1);
+  ck_assert_int_eq(error, OK);
+
+  rez.bits[0] = MAXBITS;
+  rez.bits[1] = MAXBITS;
+  rez.bits[2] = MAXBITS;
+  rez.bits[3] = MINUS;
+  set_scale(&rez, 28);
+  error = s21_from_decimal_to_double(rez, &my_double);
+  ck_assert_double_eq(my_double, -7.9228162514264337593543950335);
+  ck_assert_int_eq(error, OK);
+
+  rez.bits[0] = 123456789;
+  rez.bits[1] = 0;
+  rez.bits[2] = 0;
+  rez.bits[3] = 0;
+  set_scale(&rez, 4);
+  error = s21_from_decimal_to_double(rez, &my_double);
+  ck_assert_double_eq(my_double, 12345.6789);
+  ck_assert_int_eq(error, OK);
+
+  rez.bits[0] = 1;
+  rez.bits[3] = 0;
+  set_scale(&rez, 29);
+  error = s21_from_decimal_to_double(rez, &my_double);
+  ck_assert_double_eq(my_double, 0.0);
+  ck_assert_int_eq(error, ERROR);
 }
 END_TEST
 
@@ -1483,6 +2565,21 @@ START_TEST(test_s21_floor) {
   ck_assert_int_eq(result_origin.bits[3], result_our.bits[3]);
   ck_assert_int_eq(val, OK);
 
+  src1.bits[0] = 2;
+  src1.bits[1] = 0;
+  src1.bits[2] = 0;
+  src1.bits[3] = MINUS;
+  val = s21_floor(src1, &result_our);
+  result_origin.bits[0] = 2;
+  result_origin.bits[1] = 0;
+  result_origin.bits[2] = 0;
+  result_origin.bits[3] = MINUS;
+  ck_assert_int_eq(result_origin.bits[0], result_our.bits[0]);
+  ck_assert_int_eq(result_origin.bits[1], result_our.bits[1]);
+  ck_assert_int_eq(result_origin.bits[2], result_our.bits[2]);
+  ck_assert_int_eq(result_origin.bits[3], result_our.bits[3]);
+  ck_assert_int_eq(val, OK);
+
   src1.bits[0] = 23;
   src1.bits[1] = 0;
   src1.bits[2] = 0;
@@ -1638,6 +2735,54 @@ START_TEST(test_s21_truncate) {
 }
 END_TEST
 
+START_TEST(test_s21_rescale) {
+  s21_decimal src1 = {{15, 0, 0, 0}}, result_our;
+  int val;
+
+  // 1.5 -> 1.500
+  set_scale(&src1, 1);
+  val = s21_rescale(src1, 3, ROUND_BANK, &result_our);
+  ck_assert_int_eq(result_our.bits[0], 1500);
+  ck_assert_int_eq(result_our.bits[1], 0);
+  ck_assert_int_eq(result_our.bits[2], 0);
+  ck_assert_int_eq(result_our.bits[3], 3 << 16);
+  ck_assert_int_eq(val, OK);
+
+  // -2.345 -> -2.34 / -2.34 / -2.35 / -2.35 / -2.34
+  src1.bits[0] = 2345;
+  src1.bits[3] = MINUS;
+  set_scale(&src1, 3);
+  int rounding[] = {ROUND_BANK, ROUND_TRUNC, ROUND_HALF_UP, ROUND_FLOOR,
+                    ROUND_CEIL};
+  int expected[] = {234, 234, 235, 235, 234};
+  for (int i = 0; i < 5; i++) {
+    val = s21_rescale(src1, 2, rounding[i], &result_our);
+    ck_assert_int_eq(result_our.bits[0], expected[i]);
+    ck_assert_int_eq((unsigned)result_our.bits[3], MINUS | (2 << 16));
+    ck_assert_int_eq(val, OK);
+  }
+
+  // -0.004 -> 0.00
+  src1.bits[0] = 4;
+  src1.bits[3] = MINUS;
+  set_scale(&src1, 3);
+  val = s21_rescale(src1, 2, ROUND_BANK, &result_our);
+  ck_assert_int_eq(result_our.bits[0], 0);
+  ck_assert_int_eq(result_our.bits[3], 2 << 16);
+  ck_assert_int_eq(val, OK);
+
+  // 79228162514264337593543950335 -> 79228162514264337593543950335.0
+  src1.bits[0] = MAXBITS;
+  src1.bits[1] = MAXBITS;
+  src1.bits[2] = MAXBITS;
+  src1.bits[3] = 0;
+  val = s21_rescale(src1, 1, ROUND_BANK, &result_our);
+  ck_assert_int_eq(val, ERROR);
+  val = s21_rescale(src1, 29, ROUND_BANK, &result_our);
+  ck_assert_int_eq(val, ERROR);
+}
+END_TEST
+
 START_TEST(test_s21_negate) {
   s21_decimal src1, result_our, result_origin;
   int val;
@@ -1936,6 +3081,78 @@ START_TEST(test_s21_dec_to_int) {
   val.bits[3] = 0b10000000000001000000000000000000;
   int code = s21_from_decimal_to_int(val, &rez);
   ck_assert_int_eq(test_8, code);
+
+  val.bits[0] = 0b01010100000010111110010000000000;
+  val.bits[1] = 0b00000000000000000000000000000010;
+  val.bits[2] = 0;
+  val.bits[3] = 0b00000000000001010000000000000000;
+  code = s21_from_decimal_to_int(val, &rez);
+  ck_assert_int_eq(code, OK);
+  ck_assert_int_eq(rez, 100000);
+
+  val.bits[0] = 0b10000000000000000000000000000000;
+  val.bits[1] = 0;
+  val.bits[3] = MINUS;
+  code = s21_from_decimal_to_int(val, &rez);
+  ck_assert_int_eq(code, OK);
+  ck_assert_int_eq(rez, -MAXINT - 1);
+
+  val.bits[3] = 0;
+  code = s21_from_decimal_to_int(val, &rez);
+  ck_assert_int_eq(code, ERROR);
+  ck_assert_int_eq(rez, 0);
+}
+END_TEST
+
+START_TEST(test_s21_int64) {
+  s21_decimal val;
+  int64_t rez = 0;
+  uint64_t urez = 0;
+  ck_assert_int_eq(s21_from_int64_to_decimal(INT64_MIN, &val), OK);
+  ck_assert_int_eq(val.bits[0], 0);
+  ck_assert_int_eq((unsigned)val.bits[1], 0x80000000u);
+  ck_assert_int_eq(val.bits[2], 0);
+  ck_assert_int_eq((unsigned)val.bits[3], MINUS);
+  ck_assert_int_eq(s21_from_decimal_to_int64(val, &rez), OK);
+  ck_assert(rez == INT64_MIN);
+  ck_assert_int_eq(s21_from_decimal_to_uint64(val, &urez), ERROR);
+  ck_assert(urez == 0);
+
+  val.bits[3] = 0;
+  ck_assert_int_eq(s21_from_decimal_to_int64(val, &rez), ERROR);
+  ck_assert(rez == 0);
+  ck_assert_int_eq(s21_from_decimal_to_uint64(val, &urez), OK);
+  ck_assert(urez == 0x8000000000000000ULL);
+
+  s21_from_uint64_to_decimal(UINT64_MAX, &val);
+  ck_assert_int_eq(val.bits[0], -1);
+  ck_assert_int_eq(val.bits[1], -1);
+  ck_assert_int_eq(val.bits[2], 0);
+  ck_assert_int_eq(val.bits[3], 0);
+  set_scale(&val, 19);
+  ck_assert_int_eq(s21_from_decimal_to_int64(val, &rez), OK);
+  ck_assert(rez == 1);
+
+  val.bits[3] = MINUS;
+  set_scale(&val, 20);
+  ck_assert_int_eq(s21_from_decimal_to_uint64(val, &urez), OK);
+  ck_assert(urez == 0);
+
+  val.bits[2] = 1;
+  val.bits[3] = 0;
+  ck_assert_int_eq(s21_from_decimal_to_uint64(val, &urez), ERROR);
+
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 big = ((unsigned __int128)1 << 96) - 1, big_rez = 0;
+  ck_assert_int_eq(s21_from_uint128_to_decimal(big, &val), OK);
+  ck_assert_int_eq(val.bits[0], -1);
+  ck_assert_int_eq(val.bits[1], -1);
+  ck_assert_int_eq(val.bits[2], -1);
+  ck_assert_int_eq(s21_from_decimal_to_uint128(val, &big_rez), OK);
+  ck_assert(big_rez == big);
+  ck_assert_int_eq(s21_from_uint128_to_decimal(big + 1, &val), ERROR);
+  ck_assert_int_eq(val.bits[2], 0);
+#endif
 }
 END_TEST
 
@@ -2205,6 +3422,53 @@ START_TEST(test_s21_div) {
   ck_assert_int_eq(rez.bits[1], our_rez.bits[1]);
   ck_assert_int_eq(rez.bits[2], our_rez.bits[2]);
   ck_assert_int_eq(rez.bits[3], our_rez.bits[3]);
+
+  // test13 1/3=0.3333333333333333333333333333
+  val1.bits[0] = 1;
+  val1.bits[1] = 0;
+  val1.bits[2] = 0;
+  val1.bits[3] = 0;
+
+  val2.bits[0] = 3;
+  val2.bits[1] = 0;
+  val2.bits[2] = 0;
+  val2.bits[3] = 0;
+
+  rez.bits[0] = 89478485;
+  rez.bits[1] = 347537611;
+  rez.bits[2] = 180700362;
+  rez.bits[3] = 28 << 16;
+
+  origin_check = s21_div(val1, val2, &our_rez);
+  ck_assert_int_eq(rez.bits[0], our_rez.bits[0]);
+  ck_assert_int_eq(rez.bits[1], our_rez.bits[1]);
+  ck_assert_int_eq(rez.bits[2], our_rez.bits[2]);
+  ck_assert_int_eq(rez.bits[3], our_rez.bits[3]);
+  ck_assert_int_eq(origin_check, OK);
+
+  // test14 79228162514264337593543950335/-18446744073709551616
+  // =-4294967295.9999999999999999999
+  val1.bits[0] = MAXBITS;
+  val1.bits[1] = MAXBITS;
+  val1.bits[2] = MAXBITS;
+  val1.bits[3] = 0;
+
+  val2.bits[0] = 0;
+  val2.bits[1] = 0;
+  val2.bits[2] = 1;
+  val2.bits[3] = MINUS;
+
+  rez.bits[0] = MAXBITS;
+  rez.bits[1] = 2313682943U;
+  rez.bits[2] = 2328306436U;
+  rez.bits[3] = MINUS | (19 << 16);
+
+  origin_check = s21_div(val1, val2, &our_rez);
+  ck_assert_int_eq(rez.bits[0], our_rez.bits[0]);
+  ck_assert_int_eq(rez.bits[1], our_rez.bits[1]);
+  ck_assert_int_eq(rez.bits[2], our_rez.bits[2]);
+  ck_assert_int_eq(rez.bits[3], our_rez.bits[3]);
+  ck_assert_int_eq(origin_check, OK);
 }
 END_TEST
 
@@ -2414,6 +3678,29 @@ START_TEST(test_s21_mod) {
   ck_assert_int_eq(rez.bits[1], our_rez.bits[1]);
   ck_assert_int_eq(rez.bits[2], our_rez.bits[2]);
   ck_assert_int_eq(rez.bits[3], our_rez.bits[3]);
+
+  // test 10 79228162514264337593543950335 % 18446744073709551616
+  val1.bits[0] = MAXBITS;
+  val1.bits[1] = MAXBITS;
+  val1.bits[2] = MAXBITS;
+  val1.bits[3] = 0;
+
+  val2.bits[0] = 0;
+  val2.bits[1] = 0;
+  val2.bits[2] = 1;
+  val2.bits[3] = 0;
+
+  rez.bits[0] = MAXBITS;
+  rez.bits[1] = MAXBITS;
+  rez.bits[2] = 0;
+  rez.bits[3] = 0;
+
+  our_check = s21_mod(val1, val2, &our_rez);
+  ck_assert_int_eq(rez.bits[0], our_rez.bits[0]);
+  ck_assert_int_eq(rez.bits[1], our_rez.bits[1]);
+  ck_assert_int_eq(rez.bits[2], our_rez.bits[2]);
+  ck_assert_int_eq(rez.bits[3], our_rez.bits[3]);
+  ck_assert_int_eq(our_check, OK);
 }
 END_TEST
 
@@ -2476,23 +3763,44 @@ int main(void) {
   tcase_add_test(tc, test_s21_add);
   tcase_add_test(tc, test_s21_sub);
   tcase_add_test(tc, test_s21_mul);
+  tcase_add_test(tc, test_s21_fast_stats);
+  tcase_add_test(tc, test_s21_fma);
+  tcase_add_test(tc, test_s21_dot);
+  tcase_add_test(tc, test_s21_accumulator);
+  tcase_add_test(tc, test_s21_column);
+  tcase_add_test(tc, test_s21_batch);
+  tcase_add_test(tc, test_s21_column_add);
+  tcase_add_test(tc, test_s21_aggregate);
+  tcase_add_test(tc, test_s21_parallel);
+  tcase_add_test(tc, test_s21_sort);
+  tcase_add_test(tc, test_s21_normalize);
+  tcase_add_test(tc, test_s21_map);
+  tcase_add_test(tc, test_s21_group_by);
+  tcase_add_test(tc, test_s21_from_chars);
+  tcase_add_test(tc, test_s21_from_chars_digits);
+  tcase_add_test(tc, test_s21_to_chars);
+  tcase_add_test(tc, test_s21_format);
   tcase_add_test(tc, test_s21_is_less);
   tcase_add_test(tc, test_s21_is_greater);
   tcase_add_test(tc, test_s21_is_equal);
   tcase_add_test(tc, test_s21_is_not_equal);
   tcase_add_test(tc, test_s21_is_less_or_equal);
   tcase_add_test(tc, test_s21_is_greater_or_equal);
+  tcase_add_test(tc, test_s21_compare);
   tcase_add_test(tc, test_s21_from_float_to_decimal);
   tcase_add_test(tc, test_s21_dec_to_float);
+  tcase_add_test(tc, test_s21_dec_to_double);
   tcase_add_test(tc, test_s21_buh);
   tcase_add_test(tc, test_s21_int_to_dec);
   tcase_add_test(tc, test_s21_dec_to_int);
+  tcase_add_test(tc, test_s21_int64);
   tcase_add_test(tc, test_s21_div);
   tcase_add_test(tc, test_s21_mod);
   tcase_add_test(tc, test_s21_floor);
   tcase_add_test(tc, test_s21_round);
   tcase_add_test(tc, test_s21_truncate);
   tcase_add_test(tc, test_s21_negate);
+  tcase_add_test(tc, test_s21_rescale);
   tcase_add_test(tc, test_s21_set_exp);
   tcase_add_test(tc, test_s21_shift_str);
   srunner_run_all(sr, CK_ENV);